@@ -0,0 +1,321 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataStructures/DynamicArray.hpp"
+#include "DataStructures/SmallDynamicArray.hpp"
+
+// Every allocation of the program goes through the counting operator new,
+// so payload allocations such as string buffers are counted as well.
+static std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p{std::malloc(size == 0 ? 1 : size)})
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+std::vector<std::string> getStrings(int n)
+{
+    // Longer than the small string buffer, so every copy allocates.
+    std::vector<std::string> strings;
+    strings.reserve(n);
+    for (int i{0}; i < n; ++i)
+    {
+        strings.push_back(std::string(40, 'a') + std::to_string(i));
+    }
+    return strings;
+}
+
+template <typename InsertFunction>
+void benchmarkInsert(benchmark::State& state, InsertFunction insertFunction)
+{
+    int n{static_cast<int>(state.range(0))};
+    std::size_t counted{0};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<std::string> strings{getStrings(n)};
+        std::size_t before{allocations.load(std::memory_order_relaxed)};
+        state.ResumeTiming();
+        insertFunction(strings);
+        state.PauseTiming();
+        counted += allocations.load(std::memory_order_relaxed) - before;
+        strings.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["allocations/element"] = benchmark::Counter(
+        static_cast<double>(counted) / n, benchmark::Counter::kAvgIterations);
+}
+
+// ------- Appending strings -----------------------------
+
+void BM_DynamicArrayInsertCopy(benchmark::State& state)
+{
+    benchmarkInsert(state, [](std::vector<std::string>& strings) {
+        DynamicArray<std::string> array;
+        for (const std::string& s : strings)
+        {
+            array.insert(s);
+        }
+        benchmark::DoNotOptimize(array.begin());
+    });
+}
+
+void BM_DynamicArrayInsertMove(benchmark::State& state)
+{
+    benchmarkInsert(state, [](std::vector<std::string>& strings) {
+        DynamicArray<std::string> array;
+        for (std::string& s : strings)
+        {
+            array.insert(std::move(s));
+        }
+        benchmark::DoNotOptimize(array.begin());
+    });
+}
+
+void BM_DynamicArrayEmplace(benchmark::State& state)
+{
+    benchmarkInsert(state, [](std::vector<std::string>& strings) {
+        DynamicArray<std::string> array;
+        for (std::string& s : strings)
+        {
+            array.emplace(s.size(), 'a');
+        }
+        benchmark::DoNotOptimize(array.begin());
+    });
+}
+
+void BM_DynamicArrayAppendMove(benchmark::State& state)
+{
+    benchmarkInsert(state, [](std::vector<std::string>& strings) {
+        DynamicArray<std::string> array;
+        array.append(std::make_move_iterator(strings.begin()),
+                     std::make_move_iterator(strings.end()));
+        benchmark::DoNotOptimize(array.begin());
+    });
+}
+
+void BM_VectorPushBackMove(benchmark::State& state)
+{
+    benchmarkInsert(state, [](std::vector<std::string>& strings) {
+        std::vector<std::string> vector;
+        for (std::string& s : strings)
+        {
+            vector.push_back(std::move(s));
+        }
+        benchmark::DoNotOptimize(vector.data());
+    });
+}
+
+BENCHMARK(BM_DynamicArrayInsertCopy)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_DynamicArrayInsertMove)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_DynamicArrayEmplace)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_DynamicArrayAppendMove)->Range(1 << 6, 1 << 16);
+BENCHMARK(BM_VectorPushBackMove)->Range(1 << 6, 1 << 16);
+
+// ------- Growing arrays of integers -----------------------------
+
+void BM_DynamicArrayGrowInts(benchmark::State& state)
+{
+    auto n{static_cast<std::uint32_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        DynamicArray<std::uint64_t> array;
+        for (std::uint32_t i{0}; i < n; ++i)
+        {
+            array.insert(i);
+        }
+        benchmark::DoNotOptimize(array.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+void BM_VectorGrowInts(benchmark::State& state)
+{
+    auto n{static_cast<std::uint32_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        std::vector<std::uint64_t> vector;
+        for (std::uint32_t i{0}; i < n; ++i)
+        {
+            vector.push_back(i);
+        }
+        benchmark::DoNotOptimize(vector.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint64_t));
+}
+
+void BM_DynamicArrayCompareInts(benchmark::State& state)
+{
+    auto n{static_cast<std::uint32_t>(state.range(0))};
+    DynamicArray<std::uint32_t> first;
+    for (std::uint32_t i{0}; i < n; ++i)
+    {
+        first.insert(i);
+    }
+    DynamicArray<std::uint32_t> second{first};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(first == second);
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(std::uint32_t));
+}
+
+BENCHMARK(BM_DynamicArrayGrowInts)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 28)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorGrowInts)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 28)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DynamicArrayCompareInts)->Range(1 << 10, 1 << 24);
+
+// ------- Insert and remove around a capacity boundary -----------------------
+
+void BM_DynamicArrayInsertRemoveAtBoundary(benchmark::State& state)
+{
+    // Short strings need no buffer of their own, every allocation counted
+    // is one of the array. The array holds a power of two elements just
+    // after growing past it.
+    DynamicArray<std::string> array;
+    while (array.size() <= static_cast<std::uint32_t>(state.range(0)))
+    {
+        array.insert("x");
+    }
+    array.remove(array.size() - 1);
+    std::size_t before{allocations.load(std::memory_order_relaxed)};
+    for (auto _ : state)
+    {
+        array.remove(array.size() - 1);
+        array.insert("x");
+        array.insert("x");
+        array.remove(array.size() - 1);
+    }
+    state.counters["allocations/op"] = benchmark::Counter(
+        static_cast<double>(allocations.load(std::memory_order_relaxed) -
+                            before) /
+            4,
+        benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_DynamicArrayInsertRemoveAtBoundary)->Arg(1 << 10)->Arg(1 << 16);
+
+// ------- Short-lived small arrays -----------------------------
+
+// Short strings need no buffer of their own, every allocation counted is one
+// of the array.
+template <typename Array>
+void benchmarkShortLived(benchmark::State& state)
+{
+    auto n{static_cast<std::uint32_t>(state.range(0))};
+    std::size_t before{allocations.load(std::memory_order_relaxed)};
+    for (auto _ : state)
+    {
+        Array array;
+        for (std::uint32_t i{0}; i < n; ++i)
+        {
+            array.insert("x");
+        }
+        benchmark::DoNotOptimize(array.begin());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.counters["allocations/op"] = benchmark::Counter(
+        static_cast<double>(allocations.load(std::memory_order_relaxed) -
+                            before),
+        benchmark::Counter::kAvgIterations);
+}
+
+void BM_DynamicArrayShortLived(benchmark::State& state)
+{
+    benchmarkShortLived<DynamicArray<std::string>>(state);
+}
+
+void BM_SmallDynamicArrayShortLived(benchmark::State& state)
+{
+    benchmarkShortLived<SmallDynamicArray<std::string, 16>>(state);
+}
+
+BENCHMARK(BM_DynamicArrayShortLived)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_SmallDynamicArrayShortLived)->Arg(4)->Arg(16)->Arg(64);
+
+// ------- Request scoped arrays -----------------------------
+
+// A request builds a few short lived arrays of range(0) short strings each.
+template <typename MakeArray>
+void benchmarkRequest(benchmark::State& state, MakeArray makeArray)
+{
+    auto n{static_cast<std::uint32_t>(state.range(0))};
+    std::size_t before{allocations.load(std::memory_order_relaxed)};
+    for (auto _ : state)
+    {
+        makeArray([n](auto& array) {
+            for (std::uint32_t i{0}; i < n; ++i)
+            {
+                array.insert("x");
+            }
+            benchmark::DoNotOptimize(array.begin());
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * n * 8);
+    state.counters["allocations/request"] = benchmark::Counter(
+        static_cast<double>(allocations.load(std::memory_order_relaxed) -
+                            before),
+        benchmark::Counter::kAvgIterations);
+}
+
+void BM_DynamicArrayRequestDefault(benchmark::State& state)
+{
+    benchmarkRequest(state, [](auto fill) {
+        for (int k{0}; k < 8; ++k)
+        {
+            DynamicArray<std::string> array;
+            fill(array);
+        }
+    });
+}
+
+void BM_DynamicArrayRequestArena(benchmark::State& state)
+{
+    benchmarkRequest(state, [](auto fill) {
+        alignas(std::max_align_t) unsigned char buffer[1 << 16];
+        std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer)};
+        using Allocator = std::pmr::polymorphic_allocator<std::string>;
+        for (int k{0}; k < 8; ++k)
+        {
+            DynamicArray<std::string, Allocator> array{&arena};
+            fill(array);
+        }
+    });
+}
+
+BENCHMARK(BM_DynamicArrayRequestDefault)->Arg(4)->Arg(32)->Arg(128);
+BENCHMARK(BM_DynamicArrayRequestArena)->Arg(4)->Arg(32)->Arg(128);
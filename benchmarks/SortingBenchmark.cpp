@@ -0,0 +1,1056 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/AdaptiveSort.hpp"
+#include "Algorithms/ArgSort.hpp"
+#include "Algorithms/GroupBy.hpp"
+#include "Algorithms/KWayMerge.hpp"
+#include "Algorithms/Selection.hpp"
+#include "Algorithms/Sorting.hpp"
+#include "Algorithms/SortingNetworks.hpp"
+#include "Algorithms/StringSort.hpp"
+
+std::vector<int> getRandomNumbers(int n)
+{
+    std::mt19937 g(42);
+    std::vector<int> numbers(n);
+    for (int& x : numbers)
+    {
+        x = static_cast<int>(g());
+    }
+    return numbers;
+}
+
+std::vector<int> getSortedWithRandomTail(int n)
+{
+    // Sorted file with 1% of appended records.
+    std::vector<int> numbers{getRandomNumbers(n)};
+    std::sort(numbers.begin(), numbers.end() - n / 100);
+    return numbers;
+}
+
+std::vector<int> getNearlySorted(int n)
+{
+    // Sorted numbers with 1% of elements swapped at random.
+    std::mt19937 g(42);
+    std::vector<int> numbers(n);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    for (int i{0}; i < n / 100; ++i)
+    {
+        std::swap(numbers[index(g)], numbers[index(g)]);
+    }
+    return numbers;
+}
+
+std::vector<int> getFewUnique(int n)
+{
+    // Random keys out of 16 distinct values.
+    std::vector<int> numbers{getRandomNumbers(n)};
+    for (int& x : numbers)
+    {
+        x &= 15;
+    }
+    return numbers;
+}
+
+template <typename SortFunction>
+void benchmarkSort(benchmark::State& state, SortFunction sortFunction,
+                   std::vector<int> (*generator)(int) = getRandomNumbers)
+{
+    int n{static_cast<int>(state.range(0))};
+    std::vector<int> input{generator(n)};
+    std::vector<int> numbers(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        numbers = input;
+        state.ResumeTiming();
+        sortFunction(numbers.data(), n);
+        benchmark::DoNotOptimize(numbers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// ------- Parallel Merge Sort scaling -----------------------------
+
+void BM_MergeSort(benchmark::State& state)
+{
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::mergeSort(numbers, n); });
+}
+
+void BM_ParallelMergeSort(benchmark::State& state)
+{
+    auto threads{static_cast<unsigned>(state.range(1))};
+    benchmarkSort(state, [threads](int* numbers, int n) {
+        sort::parallelMergeSort(numbers, n, threads);
+    });
+}
+
+BENCHMARK(BM_MergeSort)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelMergeSort)
+    ->ArgsProduct({{1 << 24}, {1, 2, 4, 8, 16, 32}})
+    ->ArgNames({"n", "threads"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// ------- Parallel Radix Sort scaling -----------------------------
+
+template <typename T>
+void benchmarkRadixSort(benchmark::State& state, unsigned threads)
+{
+    // Threads 0 stands for the sequential sort::radixSort.
+    auto n{static_cast<std::size_t>(state.range(0))};
+    std::mt19937_64 g(42);
+    std::vector<T> input(n);
+    for (T& x : input)
+    {
+        x = static_cast<T>(g());
+    }
+    std::vector<T> keys(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        keys = input;
+        state.ResumeTiming();
+        if (threads == 0)
+        {
+            sort::radixSort(keys.begin(), keys.end());
+        }
+        else
+        {
+            sort::parallelRadixSort(keys.begin(), keys.end(), threads);
+        }
+        benchmark::DoNotOptimize(keys.data());
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(T));
+}
+
+void BM_RadixSort32(benchmark::State& state)
+{
+    benchmarkRadixSort<uint32_t>(state, 0);
+}
+
+void BM_RadixSort64(benchmark::State& state)
+{
+    benchmarkRadixSort<uint64_t>(state, 0);
+}
+
+void BM_ParallelRadixSort32(benchmark::State& state)
+{
+    benchmarkRadixSort<uint32_t>(state,
+                                 static_cast<unsigned>(state.range(1)));
+}
+
+void BM_ParallelRadixSort64(benchmark::State& state)
+{
+    benchmarkRadixSort<uint64_t>(state,
+                                 static_cast<unsigned>(state.range(1)));
+}
+
+BENCHMARK(BM_RadixSort32)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RadixSort64)->Arg(1 << 24)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelRadixSort32)
+    ->ArgsProduct({{1 << 24}, {1, 2, 4, 8, 16}})
+    ->ArgNames({"n", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_ParallelRadixSort64)
+    ->ArgsProduct({{1 << 24}, {1, 2, 4, 8, 16}})
+    ->ArgNames({"n", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// ------- Adaptive sorting on partially sorted input -----------------------
+
+void BM_TimSortRandom(benchmark::State& state)
+{
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::timSort(numbers, n); });
+}
+
+void BM_TimSortSortedWithTail(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::timSort(numbers, n); },
+        getSortedWithRandomTail);
+}
+
+void BM_MergeSortSortedWithTail(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::mergeSort(numbers, n); },
+        getSortedWithRandomTail);
+}
+
+void BM_TimSortNearlySorted(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::timSort(numbers, n); },
+        getNearlySorted);
+}
+
+void BM_MergeSortNearlySorted(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::mergeSort(numbers, n); },
+        getNearlySorted);
+}
+
+BENCHMARK(BM_TimSortRandom)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_TimSortSortedWithTail)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_MergeSortSortedWithTail)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_TimSortNearlySorted)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_MergeSortNearlySorted)->Range(1 << 10, 1 << 22);
+
+// ------- Sorting networks on small blocks -----------------------------
+
+void benchmarkSmallBlocks(benchmark::State& state,
+                          void (*sortFunction)(int*, std::size_t))
+{
+    // Many independent blocks, as in the leaves of a larger sort.
+    int blockSize{static_cast<int>(state.range(0))};
+    int n{1 << 16};
+    std::vector<int> input{getRandomNumbers(n)};
+    std::vector<int> numbers(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        numbers = input;
+        state.ResumeTiming();
+        for (int low{0}; low + blockSize <= n; low += blockSize)
+        {
+            sortFunction(numbers.data() + low,
+                         static_cast<std::size_t>(blockSize));
+        }
+        benchmark::DoNotOptimize(numbers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_InsertionSortSmallBlocks(benchmark::State& state)
+{
+    benchmarkSmallBlocks(state, sort::insertionSort);
+}
+
+void BM_NetworkSortSmallBlocks(benchmark::State& state)
+{
+    auto level{static_cast<sort::SimdLevel>(state.range(1))};
+    state.SetLabel(sort::setSimdLevel(level) == level ? "" : "unsupported");
+    benchmarkSmallBlocks(state, sort::networkSort);
+    sort::setSimdLevel(sort::SimdLevel::AVX2);
+}
+
+void BM_IntMergeSortSimdLevel(benchmark::State& state)
+{
+    auto level{static_cast<sort::SimdLevel>(state.range(1))};
+    state.SetLabel(sort::setSimdLevel(level) == level ? "" : "unsupported");
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::mergeSort(numbers, n); });
+    sort::setSimdLevel(sort::SimdLevel::AVX2);
+}
+
+void BM_GenericMergeSort(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::mergeSort(numbers, numbers + n);
+    });
+}
+
+BENCHMARK(BM_InsertionSortSmallBlocks)->RangeMultiplier(2)->Range(8, 64);
+BENCHMARK(BM_NetworkSortSmallBlocks)
+    ->ArgsProduct({{8, 16, 32, 64}, {0, 1, 2}})
+    ->ArgNames({"block", "simd"});
+BENCHMARK(BM_IntMergeSortSimdLevel)
+    ->ArgsProduct({{1 << 20}, {0, 1, 2}})
+    ->ArgNames({"n", "simd"});
+BENCHMARK(BM_GenericMergeSort)->Arg(1 << 20);
+
+// ------- Block partitioning against introsort -----------------------------
+
+void BM_QuickSortRandom(benchmark::State& state)
+{
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::quickSort(numbers, n); });
+}
+
+void BM_PdqSortRandom(benchmark::State& state)
+{
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::pdqSort(numbers, n); });
+}
+
+void BM_QuickSortNearlySorted(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::quickSort(numbers, n); },
+        getNearlySorted);
+}
+
+void BM_PdqSortNearlySorted(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::pdqSort(numbers, n); },
+        getNearlySorted);
+}
+
+void BM_QuickSortFewUnique(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::quickSort(numbers, n); },
+        getFewUnique);
+}
+
+void BM_PdqSortFewUnique(benchmark::State& state)
+{
+    benchmarkSort(
+        state, [](int* numbers, int n) { sort::pdqSort(numbers, n); },
+        getFewUnique);
+}
+
+BENCHMARK(BM_QuickSortRandom)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PdqSortRandom)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_QuickSortNearlySorted)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PdqSortNearlySorted)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_QuickSortFewUnique)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_PdqSortFewUnique)->Range(1 << 10, 1 << 22);
+
+// ------- Top 100 selection -----------------------------
+
+constexpr int TOP_K{100};
+
+void BM_TopKFullSort(benchmark::State& state)
+{
+    benchmarkSort(state,
+                  [](int* numbers, int n) { sort::pdqSort(numbers, n); });
+}
+
+void BM_TopKPartialSort(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::partialSort(numbers, numbers + TOP_K, numbers + n,
+                          std::greater<>{});
+    });
+}
+
+void BM_TopKNthElement(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::nthElement(numbers, numbers + TOP_K - 1, numbers + n,
+                         std::greater<>{});
+        sort::pdqSort(numbers, numbers + TOP_K, std::greater<>{});
+    });
+}
+
+void BM_TopKStreaming(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::TopK<int> top(TOP_K);
+        top.push(numbers, numbers + n);
+        benchmark::DoNotOptimize(top.values());
+    });
+}
+
+BENCHMARK(BM_TopKFullSort)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKPartialSort)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKNthElement)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKStreaming)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+// ------- Heap sort layouts -----------------------------
+
+void recursiveHeapify(int* numbers, int n, int index)
+{
+    // Heapify of the original heap sort, kept as a baseline.
+    int largest{index};
+    int leftChild{2 * index + 1};
+    int rightChild{2 * index + 2};
+    if (leftChild < n && numbers[largest] < numbers[leftChild])
+    {
+        largest = leftChild;
+    }
+    if (rightChild < n && numbers[largest] < numbers[rightChild])
+    {
+        largest = rightChild;
+    }
+    if (largest != index)
+    {
+        std::swap(numbers[largest], numbers[index]);
+        recursiveHeapify(numbers, n, largest);
+    }
+}
+
+void BM_HeapSortRecursive(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        for (int i{n / 2 - 1}; i >= 0; --i)
+        {
+            recursiveHeapify(numbers, n, i);
+        }
+        for (int i{n - 1}; i > 0; --i)
+        {
+            std::swap(numbers[0], numbers[i]);
+            recursiveHeapify(numbers, i, 0);
+        }
+    });
+}
+
+void BM_HeapSortBinary(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::heapSort<2>(numbers, numbers + n);
+    });
+}
+
+void BM_HeapSortQuaternary(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        sort::heapSort<4>(numbers, numbers + n);
+    });
+}
+
+BENCHMARK(BM_HeapSortRecursive)
+    ->RangeMultiplier(10)
+    ->Range(1'000'000, 100'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HeapSortBinary)
+    ->RangeMultiplier(10)
+    ->Range(1'000'000, 100'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HeapSortQuaternary)
+    ->RangeMultiplier(10)
+    ->Range(1'000'000, 100'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+// ------- Floating point keys -----------------------------
+
+void BM_DoubleStdSort(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        std::vector<double> scores(numbers, numbers + n);
+        std::sort(scores.begin(), scores.end());
+        benchmark::DoNotOptimize(scores.data());
+    });
+}
+
+void BM_DoubleRadixSort(benchmark::State& state)
+{
+    benchmarkSort(state, [](int* numbers, int n) {
+        std::vector<double> scores(numbers, numbers + n);
+        sort::radixSort(scores.data(), scores.size());
+        benchmark::DoNotOptimize(scores.data());
+    });
+}
+
+BENCHMARK(BM_DoubleStdSort)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DoubleRadixSort)->Arg(1 << 22)->Unit(benchmark::kMillisecond);
+
+// ------- Merging sorted shards -----------------------------
+
+std::vector<std::vector<int>> getSortedShards(int shards, int n)
+{
+    std::vector<int> numbers{getRandomNumbers(n)};
+    std::vector<std::vector<int>> result(shards);
+    for (int i{0}; i < shards; ++i)
+    {
+        result[i].assign(numbers.begin() + i * (n / shards),
+                         numbers.begin() + (i + 1) * (n / shards));
+        std::sort(result[i].begin(), result[i].end());
+    }
+    return result;
+}
+
+template <typename MergeFunction>
+void benchmarkMerge(benchmark::State& state, MergeFunction mergeFunction)
+{
+    int shards{static_cast<int>(state.range(0))};
+    int n{1 << 22};
+    std::vector<std::vector<int>> input{getSortedShards(shards, n)};
+    std::vector<int> merged(n);
+    for (auto _ : state)
+    {
+        mergeFunction(input, merged);
+        benchmark::DoNotOptimize(merged.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_MergeShardsConcatenateAndSort(benchmark::State& state)
+{
+    benchmarkMerge(state, [](const std::vector<std::vector<int>>& shards,
+                             std::vector<int>& merged) {
+        auto out{merged.begin()};
+        for (const std::vector<int>& shard : shards)
+        {
+            out = std::copy(shard.begin(), shard.end(), out);
+        }
+        sort::mergeSort(merged.data(), merged.size());
+    });
+}
+
+void BM_MergeShardsPriorityQueue(benchmark::State& state)
+{
+    benchmarkMerge(state, [](const std::vector<std::vector<int>>& shards,
+                             std::vector<int>& merged) {
+        // Heap of (next value, shard) pairs, the previous external merge.
+        using Head = std::pair<int, std::size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<>> heap;
+        std::vector<std::size_t> positions(shards.size(), 0);
+        for (std::size_t i{0}; i < shards.size(); ++i)
+        {
+            heap.push({shards[i][0], i});
+        }
+        auto out{merged.begin()};
+        while (!heap.empty())
+        {
+            std::size_t i{heap.top().second};
+            *out++ = heap.top().first;
+            heap.pop();
+            if (++positions[i] < shards[i].size())
+            {
+                heap.push({shards[i][positions[i]], i});
+            }
+        }
+    });
+}
+
+void BM_MergeShardsLoserTree(benchmark::State& state)
+{
+    benchmarkMerge(state, [](const std::vector<std::vector<int>>& shards,
+                             std::vector<int>& merged) {
+        std::vector<std::pair<const int*, const int*>> ranges;
+        for (const std::vector<int>& shard : shards)
+        {
+            ranges.emplace_back(shard.data(), shard.data() + shard.size());
+        }
+        sort::kWayMerge(ranges, merged.begin());
+    });
+}
+
+BENCHMARK(BM_MergeShardsConcatenateAndSort)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MergeShardsPriorityQueue)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MergeShardsLoserTree)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096)
+    ->Unit(benchmark::kMillisecond);
+
+// ------- String sorting -----------------------------
+
+std::vector<std::string> getUrls(int n)
+{
+    // URL-like keys, long common prefixes followed by a random path.
+    std::mt19937 g(42);
+    std::uniform_int_distribution<int> host(0, 15);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> urls(n);
+    for (std::string& url : urls)
+    {
+        url = "https://www.host" + std::to_string(host(g)) + ".com/path/";
+        for (int i{0}; i < 12; ++i)
+        {
+            url += static_cast<char>(letter(g));
+        }
+    }
+    return urls;
+}
+
+template <typename SortFunction>
+void benchmarkStringSort(benchmark::State& state, SortFunction sortFunction)
+{
+    std::vector<std::string> input{getUrls(static_cast<int>(state.range(0)))};
+    std::vector<std::string> strings;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        strings = input;
+        state.ResumeTiming();
+        sortFunction(strings);
+        benchmark::DoNotOptimize(strings.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StringStdSort(benchmark::State& state)
+{
+    benchmarkStringSort(state, [](std::vector<std::string>& strings) {
+        std::sort(strings.begin(), strings.end());
+    });
+}
+
+void BM_StringPdqSort(benchmark::State& state)
+{
+    benchmarkStringSort(state, [](std::vector<std::string>& strings) {
+        sort::pdqSort(strings.begin(), strings.end());
+    });
+}
+
+void BM_StringMultikeyQuickSort(benchmark::State& state)
+{
+    benchmarkStringSort(state, [](std::vector<std::string>& strings) {
+        sort::multikeyQuickSort(strings.begin(), strings.end());
+    });
+}
+
+void BM_StringMsdRadixSort(benchmark::State& state)
+{
+    benchmarkStringSort(state, [](std::vector<std::string>& strings) {
+        sort::msdRadixSort(strings.begin(), strings.end());
+    });
+}
+
+BENCHMARK(BM_StringStdSort)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringPdqSort)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringMultikeyQuickSort)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringMsdRadixSort)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+// ------- Adaptive sort dispatch -----------------------------
+
+// Distributions by index: random, nearly sorted, few unique, sorted with a
+// random tail, 16-bit keys.
+std::vector<int> getInputDistribution(int n, int distribution)
+{
+    switch (distribution)
+    {
+    case 1:
+        return getNearlySorted(n);
+    case 2:
+        return getFewUnique(n);
+    case 3:
+        return getSortedWithRandomTail(n);
+    case 4: {
+        std::vector<int> numbers{getRandomNumbers(n)};
+        for (int& x : numbers)
+        {
+            x &= 0xffff;
+        }
+        return numbers;
+    }
+    default:
+        return getRandomNumbers(n);
+    }
+}
+
+template <typename SortFunction>
+void benchmarkDistribution(benchmark::State& state, SortFunction sortFunction)
+{
+    int n{static_cast<int>(state.range(0))};
+    std::vector<int> input{
+        getInputDistribution(n, static_cast<int>(state.range(1)))};
+    std::vector<int> numbers(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        numbers = input;
+        state.ResumeTiming();
+        sortFunction(numbers.data(), numbers.data() + n);
+        benchmark::DoNotOptimize(numbers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_AdaptiveSort(benchmark::State& state)
+{
+    benchmarkDistribution(state, [](int* first, int* last) {
+        sort::sort(first, last);
+    });
+}
+
+void BM_AdaptivePdqSort(benchmark::State& state)
+{
+    benchmarkDistribution(state, [](int* first, int* last) {
+        sort::pdqSort(first, last);
+    });
+}
+
+void BM_AdaptiveRadixSort(benchmark::State& state)
+{
+    benchmarkDistribution(state, [](int* first, int* last) {
+        sort::radixSort(first, last);
+    });
+}
+
+void BM_AdaptiveTimSort(benchmark::State& state)
+{
+    benchmarkDistribution(state, [](int* first, int* last) {
+        sort::timSort(first, last);
+    });
+}
+
+BENCHMARK(BM_AdaptiveSort)
+    ->ArgsProduct({{1 << 6, 1 << 10, 1 << 14, 1 << 20}, {0, 1, 2, 3, 4}})
+    ->ArgNames({"n", "distribution"});
+BENCHMARK(BM_AdaptivePdqSort)
+    ->ArgsProduct({{1 << 6, 1 << 10, 1 << 14, 1 << 20}, {0, 1, 2, 3, 4}})
+    ->ArgNames({"n", "distribution"});
+BENCHMARK(BM_AdaptiveRadixSort)
+    ->ArgsProduct({{1 << 6, 1 << 10, 1 << 14, 1 << 20}, {0, 1, 2, 3, 4}})
+    ->ArgNames({"n", "distribution"});
+BENCHMARK(BM_AdaptiveTimSort)
+    ->ArgsProduct({{1 << 6, 1 << 10, 1 << 14, 1 << 20}, {0, 1, 2, 3, 4}})
+    ->ArgNames({"n", "distribution"});
+
+// ------- Every sort across input distributions -----------------------------
+
+enum class Distribution
+{
+    Random,
+    Sorted,
+    Reversed,
+    Sawtooth,
+    FewUnique,
+    Zipf
+};
+
+std::vector<int> getDistribution(int n, Distribution distribution)
+{
+    std::vector<int> numbers(n);
+    switch (distribution)
+    {
+    case Distribution::Random:
+        return getRandomNumbers(n);
+    case Distribution::Sorted:
+        std::iota(numbers.begin(), numbers.end(), 0);
+        break;
+    case Distribution::Reversed:
+        std::iota(numbers.rbegin(), numbers.rend(), 0);
+        break;
+    case Distribution::Sawtooth: {
+        // Sixteen ascending runs.
+        int tooth{std::max(n / 16, 1)};
+        for (int i{0}; i < n; ++i)
+        {
+            numbers[i] = i % tooth;
+        }
+        break;
+    }
+    case Distribution::FewUnique:
+        return getFewUnique(n);
+    case Distribution::Zipf: {
+        // Rank k out of n drawn with probability about 1 / k, ranks are
+        // scattered over the key range so frequent keys are not the
+        // smallest.
+        std::mt19937 g(42);
+        std::uniform_real_distribution<double> u(0.0, 1.0);
+        double logRanks{std::log(static_cast<double>(n) + 1.0)};
+        for (int& x : numbers)
+        {
+            auto rank{static_cast<std::uint32_t>(std::exp(u(g) * logRanks))};
+            x = static_cast<int>(rank * 2654435761U);
+        }
+        break;
+    }
+    }
+    return numbers;
+}
+
+template <typename SortFunction>
+void benchmarkEverySort(benchmark::State& state, SortFunction sortFunction)
+{
+    int n{static_cast<int>(state.range(0))};
+    std::vector<int> input{
+        getDistribution(n, static_cast<Distribution>(state.range(1)))};
+    // Small inputs are sorted in batches of copies, so refilling them with
+    // the timer paused costs little next to the sorts.
+    int copies{std::max((1 << 16) / n, 1)};
+    std::vector<int> numbers(static_cast<std::size_t>(copies) * n);
+    std::chrono::duration<double> sorting{0.0};
+    while (state.KeepRunningBatch(copies))
+    {
+        state.PauseTiming();
+        for (int i{0}; i < copies; ++i)
+        {
+            std::copy(input.begin(), input.end(),
+                      numbers.begin() + static_cast<std::ptrdiff_t>(i) * n);
+        }
+        state.ResumeTiming();
+        auto start{std::chrono::steady_clock::now()};
+        for (int i{0}; i < copies; ++i)
+        {
+            sortFunction(numbers.data() + static_cast<std::ptrdiff_t>(i) * n,
+                         static_cast<std::size_t>(n));
+        }
+        benchmark::DoNotOptimize(numbers.data());
+        sorting += std::chrono::steady_clock::now() - start;
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    // Cycles at the clock rate Google Benchmark detected.
+    double elements{static_cast<double>(state.iterations()) * n};
+    state.counters["cycles/element"] =
+        sorting.count() * benchmark::CPUInfo::Get().cycles_per_second /
+        elements;
+}
+
+// Sizes from 16 to 10^8 for O(n log n) sorts, up to 2^14 for O(n^2) sorts,
+// all of them over every distribution.
+void everySortFast(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct({benchmark::CreateRange(16, 100000000, 8),
+                            benchmark::CreateDenseRange(0, 5, 1)});
+    benchmark->ArgNames({"n", "distribution"});
+    benchmark->UseRealTime();
+}
+
+void everySortQuadratic(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct({benchmark::CreateRange(16, 1 << 14, 8),
+                            benchmark::CreateDenseRange(0, 5, 1)});
+    benchmark->ArgNames({"n", "distribution"});
+    benchmark->UseRealTime();
+}
+
+// Larger ranges fall back to quickSort and would only repeat its rows.
+void everySortNetwork(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct(
+        {benchmark::CreateRange(16, sort::NETWORK_SORT_MAX, 2),
+         benchmark::CreateDenseRange(0, 5, 1)});
+    benchmark->ArgNames({"n", "distribution"});
+    benchmark->UseRealTime();
+}
+
+void BM_EveryBubbleSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::bubbleSort(numbers, n);
+    });
+}
+
+void BM_EverySelectionSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::selectionSort(numbers, n);
+    });
+}
+
+void BM_EveryInsertionSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::insertionSort(numbers, n);
+    });
+}
+
+void BM_EveryMergeSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::mergeSort(numbers, n);
+    });
+}
+
+void BM_EveryMergeSortBuffer(benchmark::State& state)
+{
+    std::vector<int> buffer(static_cast<std::size_t>(state.range(0)));
+    benchmarkEverySort(state, [&buffer](int* numbers, std::size_t n) {
+        sort::mergeSort(numbers, n, buffer.data());
+    });
+}
+
+void BM_EveryTimSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::timSort(numbers, n);
+    });
+}
+
+void BM_EveryParallelMergeSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::parallelMergeSort(numbers, n);
+    });
+}
+
+void BM_EveryQuickSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::quickSort(numbers, n);
+    });
+}
+
+void BM_EveryPdqSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::pdqSort(numbers, n);
+    });
+}
+
+void BM_EveryHeapSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::heapSort(numbers, n);
+    });
+}
+
+void BM_EveryRadixSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::radixSort(numbers, n);
+    });
+}
+
+void BM_EveryParallelRadixSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::parallelRadixSort(numbers, n);
+    });
+}
+
+void BM_EveryNetworkSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::networkSort(numbers, n);
+    });
+}
+
+void BM_EveryAdaptiveSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        sort::sort(numbers, numbers + n);
+    });
+}
+
+void BM_EveryStdSort(benchmark::State& state)
+{
+    benchmarkEverySort(state, [](int* numbers, std::size_t n) {
+        std::sort(numbers, numbers + n);
+    });
+}
+
+BENCHMARK(BM_EveryBubbleSort)->Apply(everySortQuadratic);
+BENCHMARK(BM_EverySelectionSort)->Apply(everySortQuadratic);
+BENCHMARK(BM_EveryInsertionSort)->Apply(everySortQuadratic);
+BENCHMARK(BM_EveryMergeSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryMergeSortBuffer)->Apply(everySortFast);
+BENCHMARK(BM_EveryTimSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryParallelMergeSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryQuickSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryPdqSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryHeapSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryRadixSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryParallelRadixSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryNetworkSort)->Apply(everySortNetwork);
+BENCHMARK(BM_EveryAdaptiveSort)->Apply(everySortFast);
+BENCHMARK(BM_EveryStdSort)->Apply(everySortFast);
+
+// ------- Sort-based aggregation -----------------------------
+
+// Keys drawn from range(1) distinct values.
+std::vector<int> getGroupKeys(int n, int groups)
+{
+    std::mt19937 g(42);
+    std::uniform_int_distribution<int> key(0, groups - 1);
+    std::vector<int> keys(n);
+    for (int& x : keys)
+    {
+        x = key(g) * 40503;
+    }
+    return keys;
+}
+
+template <typename AggregateFunction>
+void benchmarkAggregate(benchmark::State& state,
+                        AggregateFunction aggregateFunction)
+{
+    int n{static_cast<int>(state.range(0))};
+    std::vector<int> input{getGroupKeys(n, static_cast<int>(state.range(1)))};
+    std::vector<int64_t> values(n, 1);
+    std::vector<int> keys(n);
+    std::vector<int64_t> aggregates(n);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        keys = input;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(aggregateFunction(keys, values, aggregates));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_SortUniqueFused(benchmark::State& state)
+{
+    benchmarkAggregate(state, [](std::vector<int>& keys,
+                                 const std::vector<int64_t>&,
+                                 std::vector<int64_t>&) {
+        return sort::sortUnique(keys.begin(), keys.end()) - keys.begin();
+    });
+}
+
+void BM_SortUniqueTwoPass(benchmark::State& state)
+{
+    benchmarkAggregate(state, [](std::vector<int>& keys,
+                                 const std::vector<int64_t>&,
+                                 std::vector<int64_t>&) {
+        sort::radixSort(keys.begin(), keys.end());
+        return std::unique(keys.begin(), keys.end()) - keys.begin();
+    });
+}
+
+void BM_GroupBySumFused(benchmark::State& state)
+{
+    benchmarkAggregate(state, [](std::vector<int>& keys,
+                                 const std::vector<int64_t>& values,
+                                 std::vector<int64_t>& aggregates) {
+        return sort::groupBy(keys.begin(), keys.end(), values.begin(),
+                             aggregates.begin(), std::plus<>{}) -
+               keys.begin();
+    });
+}
+
+void BM_GroupBySumTwoPass(benchmark::State& state)
+{
+    benchmarkAggregate(state, [](std::vector<int>& keys,
+                                 const std::vector<int64_t>& values,
+                                 std::vector<int64_t>& aggregates) {
+        std::vector<int64_t> sorted{values};
+        sort::sortByKey(keys.begin(), keys.end(), sorted.begin());
+        std::size_t groups{0};
+        for (std::size_t i{0}; i < keys.size(); ++i)
+        {
+            if (groups > 0 && keys[groups - 1] == keys[i])
+            {
+                aggregates[groups - 1] += sorted[i];
+            }
+            else
+            {
+                keys[groups] = keys[i];
+                aggregates[groups++] = sorted[i];
+            }
+        }
+        return groups;
+    });
+}
+
+BENCHMARK(BM_SortUniqueFused)
+    ->ArgsProduct({{1 << 22}, {1 << 4, 1 << 10, 1 << 16, 1 << 22}})
+    ->ArgNames({"n", "groups"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SortUniqueTwoPass)
+    ->ArgsProduct({{1 << 22}, {1 << 4, 1 << 10, 1 << 16, 1 << 22}})
+    ->ArgNames({"n", "groups"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupBySumFused)
+    ->ArgsProduct({{1 << 22}, {1 << 4, 1 << 10, 1 << 16, 1 << 22}})
+    ->ArgNames({"n", "groups"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GroupBySumTwoPass)
+    ->ArgsProduct({{1 << 22}, {1 << 4, 1 << 10, 1 << 16, 1 << 22}})
+    ->ArgNames({"n", "groups"})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+#include "Algorithms/Sorting.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Algorithm `sort::sort` dispatched to.
+ *
+ * @details `Insertion` is `sort::insertionSort`, `Merge` is `sort::timSort`,
+ * `Radix` is `sort::radixSort` and `Intro` is `sort::pdqSort`.
+ */
+enum class SortPath
+{
+    Insertion,
+    Merge,
+    Radix,
+    Intro
+};
+
+/**
+ * @brief What `sort::sort` measured on its input and which path it took.
+ *
+ * @details Measures come from a small sample of the range, not from all
+ * elements.
+ */
+struct SortDecision
+{
+    /**
+     * @brief Algorithm the range was sorted with.
+     *
+     */
+    SortPath path{SortPath::Insertion};
+
+    /**
+     * @brief Number of elements.
+     *
+     */
+    std::size_t size{0};
+
+    /**
+     * @brief Fraction of sampled neighbour pairs out of order, near 0 for
+     * presorted and near 1 for reversed input.
+     *
+     */
+    double descents{0.0};
+
+    /**
+     * @brief Fraction of sampled keys equal to another sampled key, only
+     * sampled for radix sortable keys.
+     *
+     */
+    double duplicates{0.0};
+
+    /**
+     * @brief Bytes in which the sampled keys differ, the number of radix
+     * passes that cannot be skipped, only sampled for radix sortable keys.
+     *
+     */
+    std::size_t keyBytes{0};
+};
+
+/**
+ * @brief Sort a range with the algorithm that suits the input best.
+ *
+ * @details Samples the range in `O(1)` comparisons and picks a path:
+ * tiny ranges use insertion sort, ranges whose sampled neighbours are almost
+ * all in order or almost all reversed use Timsort, which finishes runs in
+ * `O(n)`, large ranges of integer or floating point keys compared with
+ * `std::less` use LSD radix sort and the rest pattern-defeating quick sort.
+ * The radix threshold grows with the bytes in which the sampled keys differ,
+ * and ranges where most sampled keys are duplicates stay with
+ * pattern-defeating quick sort, which partitions equal keys in one pass.
+ * Every path is `O(n log n)` in the worst case, so a misleading sample costs
+ * speed only. The sort is not stable.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> values{getValues()};
+ * sort::SortDecision decision;
+ * sort::sort(values.begin(), values.end(), std::less<>{}, decision);
+ * // decision.path tells which algorithm ran
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void sort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Sort a range with the algorithm that suits the input best and
+ * report the choice.
+ *
+ * @details Same as `sort::sort(RandomIt, RandomIt, Compare)`.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @param decision Set to the sampled measures and the chosen path.
+ */
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp,
+          SortDecision& decision);
+} // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief Ranges of at most this size are sorted with insertion sort.
+ *
+ * @details Below it insertion sort matches pattern-defeating quick sort,
+ * which insertion sorts such ranges itself, and sampling would not pay off.
+ */
+constexpr std::ptrdiff_t ADAPTIVE_INSERTION_MAX{32};
+
+/**
+ * @brief Maximum number of sampled neighbour pairs.
+ *
+ * @details Smaller ranges sample one pair per
+ * `sort_impl::ADAPTIVE_PAIR_STEP` elements, so sampling stays a small part
+ * of the work.
+ */
+constexpr std::ptrdiff_t ADAPTIVE_PAIR_SAMPLE{64};
+
+/**
+ * @brief Minimum number of elements per sampled neighbour pair.
+ *
+ */
+constexpr std::ptrdiff_t ADAPTIVE_PAIR_STEP{8};
+
+/**
+ * @brief Number of sampled keys.
+ *
+ */
+constexpr int ADAPTIVE_KEY_SAMPLE{32};
+
+/**
+ * @brief Radix sort is used from this many elements per key byte in which
+ * the sampled keys differ.
+ *
+ * @details Radix sort of random 32-bit keys overtakes pattern-defeating
+ * quick sort at about 768 elements, of 16-bit keys at about 512.
+ */
+constexpr std::ptrdiff_t ADAPTIVE_RADIX_PER_BYTE{256};
+
+/**
+ * @brief Whether a range can be sorted by `sort::radixSort` instead of a
+ * comparison sort with `Compare`.
+ *
+ * @tparam T Type of the sorted values.
+ * @tparam Compare Compare function type.
+ */
+template <typename T, typename Compare>
+constexpr bool RADIX_SORTABLE{
+    HasRadixKey<T>::value && std::is_default_constructible_v<T> &&
+    (std::is_same_v<Compare, std::less<>> ||
+     std::is_same_v<Compare, std::less<T>>)};
+
+template <typename RandomIt, typename Compare>
+sort::SortDecision chooseSort(RandomIt first, RandomIt last, Compare& comp);
+} // namespace sort_impl
+
+// ------- Adaptive Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::sort(RandomIt first, RandomIt last, Compare comp)
+{
+    SortDecision decision;
+    sort::sort(first, last, comp, decision);
+}
+
+template <typename RandomIt, typename Compare>
+void sort::sort(RandomIt first, RandomIt last, Compare comp,
+                SortDecision& decision)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    decision = sort_impl::chooseSort(first, last, comp);
+    switch (decision.path)
+    {
+    case SortPath::Insertion:
+        sort::insertionSort(first, last, comp);
+        break;
+    case SortPath::Merge:
+        sort::timSort(first, last, comp);
+        break;
+    case SortPath::Radix:
+        if constexpr (sort_impl::RADIX_SORTABLE<T, Compare>)
+        {
+            sort::radixSort(first, last);
+        }
+        break;
+    case SortPath::Intro:
+        sort::pdqSort(first, last, comp);
+        break;
+    }
+}
+
+template <typename RandomIt, typename Compare>
+sort::SortDecision sort_impl::chooseSort(RandomIt first, RandomIt last,
+                                         Compare& comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    sort::SortDecision decision;
+    auto n{last - first};
+    decision.size = static_cast<std::size_t>(n);
+    if (n <= ADAPTIVE_INSERTION_MAX)
+    {
+        decision.path = sort::SortPath::Insertion;
+        return decision;
+    }
+
+    // Neighbour pairs spread over the range show how much order the input
+    // already has, runs survive in the sample unless they are shorter than
+    // the sampling step.
+    auto&& counted{sort_impl::countingCompare(comp)};
+    auto pairs{std::min(ADAPTIVE_PAIR_SAMPLE, n / ADAPTIVE_PAIR_STEP)};
+    std::ptrdiff_t descents{0};
+    for (std::ptrdiff_t k{0}; k < pairs; ++k)
+    {
+        auto i{(n - 1) * k / pairs};
+        descents += counted(first[i + 1], first[i]) ? 1 : 0;
+    }
+    decision.descents = static_cast<double>(descents) / pairs;
+    if (8 * descents <= pairs || 8 * (pairs - descents) <= pairs)
+    {
+        decision.path = sort::SortPath::Merge;
+        return decision;
+    }
+
+    decision.path = sort::SortPath::Intro;
+    if constexpr (RADIX_SORTABLE<T, Compare>)
+    {
+        if (n < ADAPTIVE_RADIX_PER_BYTE)
+        {
+            return decision;
+        }
+
+        // Sorted sample keys give the duplicate share and the key bytes
+        // that differ, radix passes over bytes all keys share are skipped.
+        using Key = typename RadixKey<T>::type;
+        std::array<Key, ADAPTIVE_KEY_SAMPLE> keys;
+        for (int k{0}; k < ADAPTIVE_KEY_SAMPLE; ++k)
+        {
+            keys[k] = RadixKey<T>::encode(first[(n - 1) * k /
+                                                (ADAPTIVE_KEY_SAMPLE - 1)]);
+        }
+        sort::insertionSort(keys.begin(), keys.end());
+        int duplicates{0};
+        for (int k{1}; k < ADAPTIVE_KEY_SAMPLE; ++k)
+        {
+            duplicates += keys[k] == keys[k - 1] ? 1 : 0;
+        }
+        decision.duplicates =
+            static_cast<double>(duplicates) / (ADAPTIVE_KEY_SAMPLE - 1);
+        auto spread{static_cast<std::uint64_t>(keys.front() ^ keys.back())};
+        std::size_t keyBytes{1};
+        for (; spread > 0xff; spread >>= 8)
+        {
+            ++keyBytes;
+        }
+        decision.keyBytes = keyBytes;
+
+        // Few distinct keys spread over several bytes are sorted faster by
+        // partitioning than by a pass per byte at any size.
+        bool fewUnique{2 * duplicates >= ADAPTIVE_KEY_SAMPLE - 1};
+        auto threshold{ADAPTIVE_RADIX_PER_BYTE *
+                       static_cast<std::ptrdiff_t>(keyBytes)};
+        if (!(fewUnique && keyBytes > 1) && n >= threshold)
+        {
+            decision.path = sort::SortPath::Radix;
+        }
+    }
+    return decision;
+}
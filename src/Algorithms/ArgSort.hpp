@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/Sorting.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Sorting permutation of a range of keys.
+ *
+ * @details Returns indices such that `first[result[0]], first[result[1]], ...`
+ * is sorted. The keys are not modified. The sort is stable, indices of equal
+ * keys stay in ascending order. Integer and floating point keys compared
+ * with `std::less<>` are sorted with an LSD radix sort of (key, index) pairs,
+ * other keys with a merge sort of the indices.
+ *
+ * Example usage:
+ * @code
+ * std::vector<double> prices{9.5, 1.25, 4.0};
+ * std::vector<std::size_t> order{sort::argSort(prices.begin(), prices.end())};
+ * // order == {1, 2, 0}
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first key.
+ * @param last Iterator to one past the last key.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @return `std::vector<std::size_t>` Indices of the keys in sorted order.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+std::vector<std::size_t> argSort(RandomIt first, RandomIt last,
+                                 Compare comp = Compare{});
+
+/**
+ * @brief Reorder a range by a permutation.
+ *
+ * @details Element `i` of the range becomes the element that was at
+ * `permutation[i]`, e.g. applying the result of `sort::argSort` sorts the
+ * range. Allocates a buffer of the range size.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @param first Iterator to the first element, the range has
+ * `permutation.size()` elements.
+ * @param permutation Permutation of `0 .. permutation.size() - 1`.
+ */
+template <typename RandomIt>
+void permute(RandomIt first, const std::vector<std::size_t>& permutation);
+
+/**
+ * @brief Sort keys in ascending order and apply the same reordering to
+ * payload columns.
+ *
+ * @details Sorts struct-of-arrays data without packing it into structs: the
+ * sorting permutation of the keys is computed once by `sort::argSort` and
+ * applied to the keys and every payload range. The sort is stable, so rows
+ * with equal keys keep their order. For other orders call `sort::argSort`
+ * with a comparator and `sort::permute` for each column.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int64_t> timestamps{30, 10, 20};
+ * std::vector<uint32_t> rowIds{0, 1, 2};
+ * std::vector<double> values{3.0, 1.0, 2.0};
+ * sort::sortByKey(timestamps.begin(), timestamps.end(), rowIds.begin(),
+ *                 values.begin());
+ * // rowIds == {1, 2, 0}
+ * @endcode
+ *
+ * @tparam KeyIt Random access iterator type of the keys.
+ * @tparam PayloadIts Random access iterator types of the payloads.
+ * @param first Iterator to the first key.
+ * @param last Iterator to one past the last key.
+ * @param payloads Iterators to the first element of each payload range,
+ * every range has as many elements as the keys.
+ */
+template <typename KeyIt, typename... PayloadIts>
+void sortByKey(KeyIt first, KeyIt last, PayloadIts... payloads);
+} // namespace sort
+
+namespace sort_impl
+{
+
+template <typename RandomIt>
+std::vector<std::size_t> radixArgSort(RandomIt first, RandomIt last);
+} // namespace sort_impl
+
+// ------- Arg Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+std::vector<std::size_t> sort::argSort(RandomIt first, RandomIt last,
+                                       Compare comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    if constexpr (sort_impl::HasRadixKey<T>::value &&
+                  std::is_same_v<Compare, std::less<>>)
+    {
+        return sort_impl::radixArgSort(first, last);
+    }
+    else
+    {
+        std::vector<std::size_t> indices(last - first);
+        std::iota(indices.begin(), indices.end(), std::size_t{0});
+        std::vector<std::size_t> buffer;
+        sort::mergeSort(indices.begin(), indices.end(), buffer,
+                        [first, &comp](std::size_t a, std::size_t b) {
+                            return comp(first[a], first[b]);
+                        });
+        return indices;
+    }
+}
+
+template <typename RandomIt>
+std::vector<std::size_t> sort_impl::radixArgSort(RandomIt first, RandomIt last)
+{
+    // Keys travel with their indices, so every pass reads memory
+    // sequentially instead of looking keys up through the indices.
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = typename RadixKey<T>::type;
+
+    auto n{static_cast<std::size_t>(last - first)};
+    std::vector<std::pair<Key, std::size_t>> keyed(n);
+    sort_impl::countScratch(n * sizeof(keyed[0]));
+    for (std::size_t i{0}; i < n; ++i)
+    {
+        keyed[i] = {RadixKey<T>::encode(first[i]), i};
+    }
+    sort_impl::radixSort(keyed.begin(), keyed.end(),
+                         [](const std::pair<Key, std::size_t>& entry) {
+                             return entry.first;
+                         });
+
+    std::vector<std::size_t> indices(n);
+    for (std::size_t i{0}; i < n; ++i)
+    {
+        indices[i] = keyed[i].second;
+    }
+    return indices;
+}
+
+// ------- Permute -----------------------------
+
+template <typename RandomIt>
+void sort::permute(RandomIt first, const std::vector<std::size_t>& permutation)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    std::vector<T> permuted;
+    permuted.reserve(permutation.size());
+    sort_impl::countScratch(permutation.size() * sizeof(T));
+    sort_impl::countMoves(2 * permutation.size());
+    for (std::size_t index : permutation)
+    {
+        permuted.push_back(std::move(first[index]));
+    }
+    std::move(permuted.begin(), permuted.end(), first);
+}
+
+// ------- Sort By Key -----------------------------
+
+template <typename KeyIt, typename... PayloadIts>
+void sort::sortByKey(KeyIt first, KeyIt last, PayloadIts... payloads)
+{
+    std::vector<std::size_t> permutation{sort::argSort(first, last)};
+    sort::permute(first, permutation);
+    (sort::permute(payloads, permutation), ...);
+}
@@ -0,0 +1,125 @@
+#include "Algorithms/ExternalSort.hpp"
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+// ------- File -----------------------------
+
+sort_impl::File::File(const std::filesystem::path& path, const char* mode)
+    : m_File(std::fopen(path.string().c_str(), mode)), m_Path(path)
+{
+    if (m_File == nullptr)
+    {
+        throw std::runtime_error("Cannot open " + m_Path.string() + "!");
+    }
+    std::setvbuf(m_File, nullptr, _IONBF, 0);
+}
+
+sort_impl::File::File(File&& other) noexcept
+    : m_File(other.m_File), m_Path(std::move(other.m_Path))
+{
+    other.m_File = nullptr;
+}
+
+sort_impl::File::~File()
+{
+    if (m_File != nullptr)
+    {
+        std::fclose(m_File);
+    }
+}
+
+std::size_t sort_impl::File::read(void* data, std::size_t size,
+                                  std::size_t count)
+{
+    std::size_t done{std::fread(data, size, count, m_File)};
+    if (done < count && std::ferror(m_File))
+    {
+        throw std::runtime_error("Cannot read " + m_Path.string() + "!");
+    }
+    return done;
+}
+
+void sort_impl::File::readAll(void* data, std::size_t size,
+                              std::size_t count)
+{
+    if (read(data, size, count) != count)
+    {
+        throw std::runtime_error("Cannot read " + m_Path.string() + "!");
+    }
+}
+
+void sort_impl::File::write(const void* data, std::size_t size,
+                            std::size_t count)
+{
+    if (std::fwrite(data, size, count, m_File) != count)
+    {
+        throw std::runtime_error("Cannot write " + m_Path.string() + "!");
+    }
+}
+
+void sort_impl::File::close()
+{
+    std::FILE* file{m_File};
+    m_File = nullptr;
+    if (std::fclose(file) != 0)
+    {
+        throw std::runtime_error("Cannot write " + m_Path.string() + "!");
+    }
+}
+
+// ------- Temporary File -----------------------------
+
+sort_impl::TemporaryFile::TemporaryFile(const std::filesystem::path& directory,
+                                        const std::string& prefix,
+                                        std::size_t index)
+    : m_Path(directory / (prefix + std::to_string(index) + ".run"))
+{
+}
+
+sort_impl::TemporaryFile::~TemporaryFile()
+{
+    if (!m_Path.empty())
+    {
+        std::error_code error;
+        std::filesystem::remove(m_Path, error);
+    }
+}
+
+sort_impl::TemporaryFile::TemporaryFile(TemporaryFile&& other) noexcept
+    : m_Path(std::move(other.m_Path))
+{
+    other.m_Path.clear();
+}
+
+sort_impl::TemporaryFile& sort_impl::TemporaryFile::operator=(
+    TemporaryFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        std::error_code error;
+        if (!m_Path.empty())
+        {
+            std::filesystem::remove(m_Path, error);
+        }
+        m_Path = std::move(other.m_Path);
+        other.m_Path.clear();
+    }
+    return *this;
+}
+
+const std::filesystem::path& sort_impl::TemporaryFile::path() const
+{
+    return m_Path;
+}
+
+std::string sort_impl::temporaryPrefix()
+{
+    std::random_device device;
+    std::ostringstream prefix;
+    prefix << "externalsort-" << std::hex << device() << device() << "-";
+    return prefix.str();
+}
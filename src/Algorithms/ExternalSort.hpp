@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Algorithms/KWayMerge.hpp"
+#include "Algorithms/Sorting.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Resource limits for `sort::externalSort`.
+ *
+ */
+struct ExternalSortOptions
+{
+    /**
+     * @brief Bytes of memory used for sorting runs and merge buffers.
+     *
+     */
+    std::size_t memoryLimit{std::size_t{1} << 28};
+
+    /**
+     * @brief Directory for temporary run files, system default if empty.
+     *
+     */
+    std::filesystem::path tempDirectory{};
+
+    /**
+     * @brief Bytes read or written per I/O call while merging runs.
+     *
+     */
+    std::size_t ioBufferSize{std::size_t{1} << 20};
+};
+
+/**
+ * @brief External merge sort for files larger than memory.
+ *
+ * @details Sorts a binary file of fixed-width records of type `T`. The input
+ * is read in chunks of half the memory limit (the other half is scratch
+ * space), each chunk is sorted in memory and written as a run to a temporary
+ * file. Runs are then merged with a `sort::LoserTree` that streams every run
+ * through a buffer of `ioBufferSize` bytes, so up to
+ * `memoryLimit / ioBufferSize - 1` runs are merged at once. If there are more
+ * runs, intermediate merge passes are done first. Input that fits into one
+ * chunk is sorted without temporary files.
+ *
+ * Integer and floating point records compared with `std::less<>` are sorted
+ * with `sort::radixSort`, everything else with `sort::mergeSort`. The sort
+ * is stable. `output` may be the same file as `input`. Temporary files are
+ * removed also if the sort fails.
+ *
+ * Example usage:
+ * @code
+ * sort::ExternalSortOptions options;
+ * options.memoryLimit = std::size_t{1} << 30;
+ * options.tempDirectory = "/scratch";
+ * sort::externalSort<uint64_t>("ids.bin", "ids.sorted.bin", options);
+ * @endcode
+ *
+ * @throws std::invalid_argument If the memory limit cannot hold two records,
+ * the I/O buffer cannot hold one or the input size is not a multiple of the
+ * record size.
+ * @throws std::runtime_error If a file cannot be opened, read or written.
+ *
+ * @tparam T Trivially copyable record type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param input Path of the file to sort.
+ * @param output Path of the file for the sorted records.
+ * @param options Memory limit, temporary directory and I/O buffer size.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename T, typename Compare = std::less<>>
+void externalSort(const std::filesystem::path& input,
+                  const std::filesystem::path& output,
+                  const ExternalSortOptions& options = {},
+                  Compare comp = Compare{});
+} // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief Unbuffered binary file, closed on destruction.
+ *
+ * @details Reads and writes go straight to the operating system, callers
+ * transfer whole blocks so stdio buffering would only add a copy.
+ */
+class File
+{
+  public:
+    File(const std::filesystem::path& path, const char* mode);
+    ~File();
+
+    File(File&& other) noexcept;
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    std::size_t read(void* data, std::size_t size, std::size_t count);
+    void readAll(void* data, std::size_t size, std::size_t count);
+    void write(const void* data, std::size_t size, std::size_t count);
+    void close();
+
+  private:
+    std::FILE* m_File;
+    std::filesystem::path m_Path;
+};
+
+/**
+ * @brief Name of a temporary file, the file is removed on destruction.
+ *
+ */
+class TemporaryFile
+{
+  public:
+    TemporaryFile(const std::filesystem::path& directory,
+                  const std::string& prefix, std::size_t index);
+    ~TemporaryFile();
+
+    TemporaryFile(TemporaryFile&& other) noexcept;
+    TemporaryFile& operator=(TemporaryFile&& other) noexcept;
+
+    const std::filesystem::path& path() const;
+
+  private:
+    std::filesystem::path m_Path;
+};
+
+// Prefix unique to one sort, so concurrent sorts can share a directory.
+std::string temporaryPrefix();
+
+template <typename T>
+class RunReader
+{
+  public:
+    RunReader(const std::filesystem::path& path, std::size_t blockSize);
+
+    bool empty() const;
+    const T& front() const;
+    void pop();
+
+  private:
+    void refill();
+
+    File m_File;
+    std::vector<T> m_Block;
+    std::size_t m_Position;
+    std::size_t m_Count;
+};
+
+template <typename T, typename Compare>
+void sortRun(std::vector<T>& run, std::vector<T>& buffer, Compare& comp);
+
+template <typename T, typename Compare>
+void mergeRuns(const TemporaryFile* first, const TemporaryFile* last,
+               const std::filesystem::path& destination, const char* mode,
+               std::size_t blockSize, Compare& comp);
+} // namespace sort_impl
+
+// ------- External Sort -----------------------------
+
+template <typename T, typename Compare>
+void sort::externalSort(const std::filesystem::path& input,
+                        const std::filesystem::path& output,
+                        const ExternalSortOptions& options, Compare comp)
+{
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Records must be trivially copyable!");
+
+    if (options.memoryLimit < 2 * sizeof(T))
+    {
+        throw std::invalid_argument("Memory limit is too small!");
+    }
+    if (options.ioBufferSize < sizeof(T))
+    {
+        throw std::invalid_argument("I/O buffer is too small!");
+    }
+
+    std::error_code error;
+    std::uintmax_t bytes{std::filesystem::file_size(input, error)};
+    if (error)
+    {
+        throw std::runtime_error("Cannot read " + input.string() + "!");
+    }
+    if (bytes % sizeof(T) != 0)
+    {
+        throw std::invalid_argument(
+            "Input size is not a multiple of the record size!");
+    }
+
+    // Half of the memory holds the run, the other half is sorting scratch.
+    std::size_t runSize{options.memoryLimit / (2 * sizeof(T))};
+    auto records{static_cast<std::size_t>(bytes / sizeof(T))};
+    std::vector<T> run(std::min(runSize, records));
+    std::vector<T> buffer;
+    sort_impl::File in(input, "rb");
+
+    if (records <= runSize)
+    {
+        in.readAll(run.data(), sizeof(T), run.size());
+        in.close();
+        sort_impl::sortRun(run, buffer, comp);
+        sort_impl::File out(output, "wb");
+        out.write(run.data(), sizeof(T), run.size());
+        out.close();
+        return;
+    }
+
+    std::filesystem::path directory{
+        options.tempDirectory.empty()
+            ? std::filesystem::temp_directory_path()
+            : options.tempDirectory};
+    std::string prefix{sort_impl::temporaryPrefix()};
+    std::size_t fileCount{0};
+
+    std::vector<sort_impl::TemporaryFile> runs;
+    for (std::size_t done{0}; done < records; done += run.size())
+    {
+        run.resize(std::min(runSize, records - done));
+        in.readAll(run.data(), sizeof(T), run.size());
+        sort_impl::sortRun(run, buffer, comp);
+        runs.emplace_back(directory, prefix, fileCount++);
+        sort_impl::File out(runs.back().path(), "wbx");
+        out.write(run.data(), sizeof(T), run.size());
+        out.close();
+    }
+    in.close();
+    // Give the sorting memory back before the merge buffers are allocated.
+    run = std::vector<T>();
+    buffer = std::vector<T>();
+
+    // One block per merged run plus one for the output.
+    std::size_t fanIn{
+        std::max<std::size_t>(options.memoryLimit / options.ioBufferSize, 3) -
+        1};
+    std::size_t blockSize{std::max<std::size_t>(
+        1, std::min(options.ioBufferSize, options.memoryLimit / (fanIn + 1)) /
+               sizeof(T))};
+
+    while (runs.size() > fanIn)
+    {
+        std::vector<sort_impl::TemporaryFile> merged;
+        for (std::size_t i{0}; i < runs.size(); i += fanIn)
+        {
+            std::size_t end{std::min(i + fanIn, runs.size())};
+            merged.emplace_back(directory, prefix, fileCount++);
+            sort_impl::mergeRuns<T>(runs.data() + i, runs.data() + end,
+                                    merged.back().path(), "wbx", blockSize,
+                                    comp);
+        }
+        // Replacing the runs removes the files of the previous pass.
+        runs = std::move(merged);
+    }
+    sort_impl::mergeRuns<T>(runs.data(), runs.data() + runs.size(), output,
+                            "wb", blockSize, comp);
+}
+
+template <typename T, typename Compare>
+void sort_impl::sortRun(std::vector<T>& run, std::vector<T>& buffer,
+                        Compare& comp)
+{
+    if constexpr (sort_impl::HasRadixKey<T>::value &&
+                  std::is_same_v<Compare, std::less<>>)
+    {
+        sort::radixSort(run.begin(), run.end());
+    }
+    else
+    {
+        sort::mergeSort(run.begin(), run.end(), buffer, comp);
+    }
+}
+
+template <typename T, typename Compare>
+void sort_impl::mergeRuns(const TemporaryFile* first,
+                          const TemporaryFile* last,
+                          const std::filesystem::path& destination,
+                          const char* mode, std::size_t blockSize,
+                          Compare& comp)
+{
+    std::vector<RunReader<T>> readers;
+    readers.reserve(last - first);
+    for (const TemporaryFile* it{first}; it != last; ++it)
+    {
+        readers.emplace_back(it->path(), blockSize);
+    }
+
+    // Merged records are collected in a block and written out at once.
+    sort::LoserTree<RunReader<T>, Compare> tree(
+        readers.data(), readers.data() + readers.size(), comp);
+    std::vector<T> block(blockSize);
+    File out(destination, mode);
+    while (!tree.empty())
+    {
+        T* end{tree.pop(block.data(), block.size())};
+        out.write(block.data(), sizeof(T),
+                  static_cast<std::size_t>(end - block.data()));
+    }
+    out.close();
+}
+
+// ------- Run Reader -----------------------------
+
+template <typename T>
+sort_impl::RunReader<T>::RunReader(const std::filesystem::path& path,
+                                   std::size_t blockSize)
+    : m_File(path, "rb"), m_Block(blockSize), m_Position(0), m_Count(0)
+{
+    refill();
+}
+
+template <typename T>
+bool sort_impl::RunReader<T>::empty() const
+{
+    return m_Position == m_Count;
+}
+
+template <typename T>
+const T& sort_impl::RunReader<T>::front() const
+{
+    return m_Block[m_Position];
+}
+
+template <typename T>
+void sort_impl::RunReader<T>::pop()
+{
+    if (++m_Position == m_Count)
+    {
+        refill();
+    }
+}
+
+template <typename T>
+void sort_impl::RunReader<T>::refill()
+{
+    m_Position = 0;
+    m_Count = m_File.read(m_Block.data(), sizeof(T), m_Block.size());
+}
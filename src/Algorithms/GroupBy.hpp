@@ -0,0 +1,509 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/Sorting.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Sort a range and remove duplicates.
+ *
+ * @details Same result as `sort::mergeSort` followed by `std::unique`, but
+ * duplicates are dropped during the last pass of the sort instead of in a
+ * second pass over the sorted range. The first of equal elements is kept.
+ * Integer and floating point values compared with `std::less<>` are sorted
+ * with an LSD radix sort that drops duplicates in its last scatter, other
+ * values with a merge sort that drops them in its last merge. Floating
+ * point `-0.0` and `0.0` are kept apart on the radix path.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> ids{4, 1, 4, 3, 1};
+ * ids.erase(sort::sortUnique(ids.begin(), ids.end()), ids.end());
+ * // ids == {1, 3, 4}
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @return `RandomIt` Iterator to one past the last unique element, elements
+ * after it are valid but unspecified.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+RandomIt sortUnique(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Sort a range, remove duplicates and count how often each element
+ * occurred.
+ *
+ * @details Counting happens during the last pass of the sort like in
+ * `sort::sortUnique`. Allocates a buffer of (key, count) pairs.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> ids{4, 1, 4, 3, 1};
+ * std::vector<std::size_t> counts(ids.size());
+ * ids.erase(sort::sortAndCount(ids.begin(), ids.end(), counts.begin()),
+ *           ids.end());
+ * // ids == {1, 3, 4}, counts starts with {2, 1, 2}
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam OutputIt Output iterator type for `std::size_t` counts.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param counts Iterator the count of each unique element is written to.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @return `RandomIt` Iterator to one past the last unique element, elements
+ * after it are valid but unspecified.
+ */
+template <typename RandomIt, typename OutputIt, typename Compare = std::less<>>
+RandomIt sortAndCount(RandomIt first, RandomIt last, OutputIt counts,
+                      Compare comp = Compare{});
+
+/**
+ * @brief Sort a key column, remove duplicate keys and aggregate a payload
+ * column per key.
+ *
+ * @details Payloads of equal keys are folded with `combine` during the last
+ * pass of the sort like in `sort::sortUnique`, in the order they appear in
+ * the input, so `combine` only needs to be associative. `std::plus<>`
+ * gives the sum, `sort::Min` and `sort::Max` the extremes. Allocates a
+ * buffer of (key, payload) pairs.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> userIds{7, 3, 7, 3, 9};
+ * std::vector<double> amounts{1.0, 2.0, 3.0, 4.0, 5.0};
+ * auto end{sort::groupBy(userIds.begin(), userIds.end(), amounts.begin(),
+ *                        amounts.begin(), std::plus<>{})};
+ * // userIds starts with {3, 7, 9}, amounts with {6.0, 4.0, 5.0}
+ * @endcode
+ *
+ * @tparam KeyIt Random access iterator type of the keys.
+ * @tparam ValueIt Input iterator type of the payloads.
+ * @tparam OutputIt Output iterator type of the aggregates.
+ * @tparam Combine Associative function, `V(const V&, const V&)`.
+ * @tparam Compare Strict weak ordering of the keys.
+ * @param first Iterator to the first key.
+ * @param last Iterator to one past the last key.
+ * @param values Iterator to the first payload, there are as many payloads
+ * as keys.
+ * @param aggregates Iterator the aggregate of each unique key is written
+ * to, may be `values`.
+ * @param combine Function folding two payloads into one.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @return `KeyIt` Iterator to one past the last unique key, keys after it
+ * are valid but unspecified.
+ */
+template <typename KeyIt, typename ValueIt, typename OutputIt,
+          typename Combine, typename Compare = std::less<>>
+KeyIt groupBy(KeyIt first, KeyIt last, ValueIt values, OutputIt aggregates,
+              Combine combine, Compare comp = Compare{});
+
+/**
+ * @brief Smaller of two values, for `sort::groupBy`.
+ *
+ */
+struct Min
+{
+    template <typename T>
+    const T& operator()(const T& a, const T& b) const
+    {
+        return b < a ? b : a;
+    }
+};
+
+/**
+ * @brief Larger of two values, for `sort::groupBy`.
+ *
+ */
+struct Max
+{
+    template <typename T>
+    const T& operator()(const T& a, const T& b) const
+    {
+        return a < b ? b : a;
+    }
+};
+} // namespace sort
+
+namespace sort_impl
+{
+
+template <typename RandomIt, typename Project, typename Compare,
+          typename Combine>
+RandomIt sortAggregate(RandomIt first, RandomIt last, Project project,
+                       Compare& comp, Combine combine);
+
+template <typename RandomIt, typename KeyOf, typename Combine>
+RandomIt radixAggregate(RandomIt first, RandomIt last, KeyOf keyOf,
+                        Combine& combine);
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf,
+          typename Combine>
+void radixScatterAggregate(SourceIt source, std::size_t n,
+                           DestinationIt destination, std::size_t* ends,
+                           int shift, KeyOf& keyOf, Combine& combine);
+
+template <typename RandomIt, typename Compare, typename Combine>
+RandomIt mergeSortAggregate(RandomIt first, RandomIt last, Compare& comp,
+                            Combine& combine);
+
+template <typename InputIt, typename OutputIt, typename Compare,
+          typename Combine>
+OutputIt mergeAggregate(InputIt first1, InputIt last1, InputIt first2,
+                        InputIt last2, OutputIt out, Compare& comp,
+                        Combine& combine);
+
+template <typename RowIt, typename KeyIt, typename OutputIt>
+KeyIt unpackRows(RowIt first, RowIt last, KeyIt keys, OutputIt aggregates);
+} // namespace sort_impl
+
+// ------- Sort Unique -----------------------------
+
+template <typename RandomIt, typename Compare>
+RandomIt sort::sortUnique(RandomIt first, RandomIt last, Compare comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    return sort_impl::sortAggregate(
+        first, last, [](const T& value) -> const T& { return value; }, comp,
+        [](T&, T&) {});
+}
+
+// ------- Sort And Count -----------------------------
+
+template <typename RandomIt, typename OutputIt, typename Compare>
+RandomIt sort::sortAndCount(RandomIt first, RandomIt last, OutputIt counts,
+                            Compare comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Row = std::pair<T, std::size_t>;
+
+    std::vector<Row> rows;
+    rows.reserve(static_cast<std::size_t>(last - first));
+    sort_impl::countScratch(rows.capacity() * sizeof(Row));
+    for (RandomIt it{first}; it != last; ++it)
+    {
+        rows.emplace_back(std::move(*it), 1);
+    }
+
+    auto end{sort_impl::sortAggregate(
+        rows.begin(), rows.end(),
+        [](const Row& row) -> const T& { return row.first; }, comp,
+        [](Row& into, Row& from) { into.second += from.second; })};
+    return sort_impl::unpackRows(rows.begin(), end, first, counts);
+}
+
+// ------- Group By -----------------------------
+
+template <typename KeyIt, typename ValueIt, typename OutputIt,
+          typename Combine, typename Compare>
+KeyIt sort::groupBy(KeyIt first, KeyIt last, ValueIt values,
+                    OutputIt aggregates, Combine combine, Compare comp)
+{
+    using K = typename std::iterator_traits<KeyIt>::value_type;
+    using V = typename std::iterator_traits<ValueIt>::value_type;
+    using Row = std::pair<K, V>;
+
+    std::vector<Row> rows;
+    rows.reserve(static_cast<std::size_t>(last - first));
+    sort_impl::countScratch(rows.capacity() * sizeof(Row));
+    for (KeyIt it{first}; it != last; ++it, ++values)
+    {
+        rows.emplace_back(std::move(*it), *values);
+    }
+
+    auto end{sort_impl::sortAggregate(
+        rows.begin(), rows.end(),
+        [](const Row& row) -> const K& { return row.first; }, comp,
+        [&combine](Row& into, Row& from) {
+            into.second = combine(into.second, from.second);
+        })};
+    return sort_impl::unpackRows(rows.begin(), end, first, aggregates);
+}
+
+template <typename RandomIt, typename Project, typename Compare,
+          typename Combine>
+RandomIt sort_impl::sortAggregate(RandomIt first, RandomIt last,
+                                  Project project, Compare& comp,
+                                  Combine combine)
+{
+    // Sorts rows by the key `project` returns and folds rows with equal keys
+    // into the first of them with `combine`.
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::decay_t<std::invoke_result_t<Project&, const T&>>;
+
+    if constexpr (HasRadixKey<Key>::value &&
+                  std::is_same_v<Compare, std::less<>>)
+    {
+        return sort_impl::radixAggregate(
+            first, last,
+            [&project](const T& row) {
+                return RadixKey<Key>::encode(project(row));
+            },
+            combine);
+    }
+    else
+    {
+        auto&& counted{sort_impl::countingCompare(comp)};
+        auto rowComp{[&project, &counted](const T& a, const T& b) {
+            return counted(project(a), project(b));
+        }};
+        return sort_impl::mergeSortAggregate(first, last, rowComp, combine);
+    }
+}
+
+template <typename RowIt, typename KeyIt, typename OutputIt>
+KeyIt sort_impl::unpackRows(RowIt first, RowIt last, KeyIt keys,
+                            OutputIt aggregates)
+{
+    sort_impl::countMoves(2 * static_cast<std::size_t>(last - first));
+    for (; first != last; ++first, ++keys, ++aggregates)
+    {
+        *keys = std::move(first->first);
+        *aggregates = std::move(first->second);
+    }
+    return keys;
+}
+
+// ------- Radix Aggregate -----------------------------
+
+template <typename RandomIt, typename KeyOf, typename Combine>
+RandomIt sort_impl::radixAggregate(RandomIt first, RandomIt last, KeyOf keyOf,
+                                   Combine& combine)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::invoke_result_t<KeyOf&, const T&>;
+    constexpr int passes{static_cast<int>(sizeof(Key))};
+
+    auto n{static_cast<std::size_t>(last - first)};
+    if (n < 2)
+    {
+        return last;
+    }
+
+    std::vector<std::array<std::size_t, RADIX_BUCKETS>> histograms(passes);
+    for (RandomIt it{first}; it != last; ++it)
+    {
+        Key key{keyOf(*it)};
+        for (int pass{0}; pass < passes; ++pass)
+        {
+            ++histograms[pass][(key >> (pass * RADIX_BITS)) &
+                               (RADIX_BUCKETS - 1)];
+        }
+    }
+
+    // Passes over digits all keys share are skipped, the last pass that is
+    // left folds equal keys instead of writing them.
+    Key firstKey{keyOf(*first)};
+    int lastPass{-1};
+    for (int pass{0}; pass < passes; ++pass)
+    {
+        if (histograms[pass][(firstKey >> (pass * RADIX_BITS)) &
+                             (RADIX_BUCKETS - 1)] != n)
+        {
+            lastPass = pass;
+        }
+    }
+    if (lastPass < 0)
+    {
+        for (RandomIt it{first + 1}; it != last; ++it)
+        {
+            combine(*first, *it);
+        }
+        return first + 1;
+    }
+
+    std::vector<T> buffer(n);
+    sort_impl::countScratch(passes * sizeof(histograms[0]) + n * sizeof(T));
+    bool inBuffer{false};
+    for (int pass{0}; pass <= lastPass; ++pass)
+    {
+        int shift{pass * RADIX_BITS};
+        auto& counts{histograms[pass]};
+        if (counts[(firstKey >> shift) & (RADIX_BUCKETS - 1)] == n)
+        {
+            continue;
+        }
+
+        std::size_t offset{0};
+        for (std::size_t& count : counts)
+        {
+            std::size_t bucketSize{count};
+            count = offset;
+            offset += bucketSize;
+        }
+
+        if (pass < lastPass)
+        {
+            if (inBuffer)
+            {
+                sort_impl::radixScatter(buffer.begin(), n, first,
+                                        counts.data(), shift, keyOf);
+            }
+            else
+            {
+                sort_impl::radixScatter(first, n, buffer.begin(),
+                                        counts.data(), shift, keyOf);
+            }
+            inBuffer = !inBuffer;
+            continue;
+        }
+
+        // Buckets end up with gaps where rows were folded, the rows left
+        // are moved together at the start of the range.
+        std::array<std::size_t, RADIX_BUCKETS> starts{counts};
+        RandomIt out{first};
+        if (inBuffer)
+        {
+            sort_impl::radixScatterAggregate(buffer.begin(), n, first,
+                                             counts.data(), shift, keyOf,
+                                             combine);
+        }
+        else
+        {
+            sort_impl::radixScatterAggregate(first, n, buffer.begin(),
+                                             counts.data(), shift, keyOf,
+                                             combine);
+        }
+        for (std::size_t digit{0}; digit < RADIX_BUCKETS; ++digit)
+        {
+            std::size_t size{counts[digit] - starts[digit]};
+            sort_impl::countMoves(size);
+            if (inBuffer)
+            {
+                RandomIt bucket{first + starts[digit]};
+                if (bucket != out)
+                {
+                    std::move(bucket, bucket + size, out);
+                }
+            }
+            else
+            {
+                auto bucket{buffer.begin() + starts[digit]};
+                std::move(bucket, bucket + size, out);
+            }
+            out += size;
+        }
+        return out;
+    }
+    return last;
+}
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf,
+          typename Combine>
+void sort_impl::radixScatterAggregate(SourceIt source, std::size_t n,
+                                      DestinationIt destination,
+                                      std::size_t* ends, int shift,
+                                      KeyOf& keyOf, Combine& combine)
+{
+    // Earlier passes left every bucket sorted, so equal keys arrive one
+    // after another and only the last key written to a bucket can match.
+    // Buckets start with a key of another digit, which matches no row.
+    using Key = std::invoke_result_t<KeyOf&, decltype(*source)>;
+    std::array<Key, RADIX_BUCKETS> lastKeys;
+    for (std::size_t digit{0}; digit < RADIX_BUCKETS; ++digit)
+    {
+        lastKeys[digit] = static_cast<Key>(static_cast<Key>(digit ^ 1)
+                                           << shift);
+    }
+    for (std::size_t i{0}; i < n; ++i, ++source)
+    {
+        Key key{keyOf(*source)};
+        auto digit{(key >> shift) & (RADIX_BUCKETS - 1)};
+        if (lastKeys[digit] == key)
+        {
+            combine(destination[ends[digit] - 1], *source);
+        }
+        else
+        {
+            lastKeys[digit] = key;
+            destination[ends[digit]++] = std::move(*source);
+            sort_impl::countMoves(1);
+        }
+    }
+}
+
+// ------- Merge Sort Aggregate -----------------------------
+
+template <typename RandomIt, typename Compare, typename Combine>
+RandomIt sort_impl::mergeSortAggregate(RandomIt first, RandomIt last,
+                                       Compare& comp, Combine& combine)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    auto n{last - first};
+    if (n < 2)
+    {
+        return last;
+    }
+
+    // Both halves are merge sorted in place, their merge into the buffer is
+    // the last pass and folds equal rows, only the rows left move back.
+    std::vector<T> buffer(static_cast<std::size_t>(n));
+    sort_impl::countScratch(buffer.size() * sizeof(T));
+    RandomIt middle{first + n / 2};
+    sort_impl::mergeSort(first, middle, buffer.begin(), comp);
+    sort_impl::mergeSort(middle, last, buffer.begin() + n / 2, comp);
+    auto end{sort_impl::mergeAggregate(first, middle, middle, last,
+                                       buffer.begin(), comp, combine)};
+    sort_impl::countMoves(static_cast<std::size_t>(end - buffer.begin()));
+    return std::move(buffer.begin(), end, first);
+}
+
+template <typename InputIt, typename OutputIt, typename Compare,
+          typename Combine>
+OutputIt sort_impl::mergeAggregate(InputIt first1, InputIt last1,
+                                   InputIt first2, InputIt last2,
+                                   OutputIt out, Compare& comp,
+                                   Combine& combine)
+{
+    // Output is sorted, a row goes into the last one written unless it
+    // compares greater.
+    OutputIt begin{out};
+    auto emit{[&](InputIt row) {
+        if (out != begin && !comp(*std::prev(out), *row))
+        {
+            combine(*std::prev(out), *row);
+        }
+        else
+        {
+            *out = std::move(*row);
+            ++out;
+            sort_impl::countMoves(1);
+        }
+    }};
+    while (first1 != last1 && first2 != last2)
+    {
+        if (comp(*first2, *first1))
+        {
+            emit(first2++);
+        }
+        else
+        {
+            emit(first1++);
+        }
+    }
+    for (; first1 != last1; ++first1)
+    {
+        emit(first1);
+    }
+    for (; first2 != last2; ++first2)
+    {
+        emit(first2);
+    }
+    return out;
+}
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/SortingStats.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Tournament tree of losers merging sorted streams.
+ *
+ * @details Merges `k` sorted streams into one. A stream is any type with
+ * `bool empty() const`, `front() const` returning the next element and
+ * `void pop()`, e.g. a cursor over a sorted range or a reader of a sorted
+ * file. Every inner node of the tree holds the next element of the stream
+ * that lost the match played there and the root holds the overall winner.
+ * Popping the winner replays only its path to the root, one match per level,
+ * `ceil(log2(k))` in total, against elements cached in the nodes, so other
+ * streams are not touched. A match takes one comparison if the node wins and
+ * two otherwise. Small trivially copyable elements and elements `front()`
+ * returns by value are cached by value and must be default constructible,
+ * others by pointer, which must stay valid until their stream is popped. The
+ * tree models the stream concept itself, so trees can be nested. Ties go to
+ * the stream with the lower index, so the merge is stable. Streams are not
+ * owned and must outlive the tree.
+ *
+ * Example usage:
+ * @code
+ * std::vector<ShardReader> shards{openShards()};
+ * sort::LoserTree<ShardReader> tree(shards.data(),
+ *                                   shards.data() + shards.size());
+ * std::vector<Record> batch(4096);
+ * while (!tree.empty())
+ * {
+ *     auto end{tree.pop(batch.begin(), batch.size())};
+ *     write(batch.begin(), end);
+ * }
+ * @endcode
+ *
+ * @tparam Stream Type of the merged streams.
+ * @tparam Compare Strict weak ordering of the stream elements.
+ */
+template <typename Stream, typename Compare = std::less<>>
+class LoserTree
+{
+  public:
+    /**
+     * @brief Type of the merged elements.
+     *
+     */
+    using Value = std::remove_cv_t<std::remove_reference_t<
+        decltype(std::declval<const Stream&>().front())>>;
+
+    /**
+     * @brief Construct a new LoserTree object and play the first tournament.
+     *
+     * @param first Pointer to the first stream.
+     * @param last Pointer to one past the last stream.
+     * @param comp Compare function, returns `true` if first argument goes
+     * first.
+     */
+    LoserTree(Stream* first, Stream* last, Compare comp = Compare{});
+
+    /**
+     * @brief Check if all streams are exhausted.
+     *
+     * @return `true` if there is no element left.
+     */
+    bool empty() const
+    {
+        return m_K == 0 || m_Tree[0].exhausted;
+    }
+
+    /**
+     * @brief Get the next element of the merge.
+     *
+     * @return Next element of the winning stream.
+     */
+    const Value& front() const
+    {
+        return value(m_Tree[0].key);
+    }
+
+    /**
+     * @brief Get the stream the next element comes from.
+     *
+     * @return `std::size_t` Index of the winning stream.
+     */
+    std::size_t winner() const
+    {
+        return m_Tree[0].stream;
+    }
+
+    /**
+     * @brief Remove the next element of the merge.
+     *
+     */
+    void pop();
+
+    /**
+     * @brief Write the next elements of the merge to an output.
+     *
+     * @details Batched form of `front()` and `pop()` for streaming the merge
+     * into a buffer, e.g. one block of an output file. Elements cached by
+     * value are moved out of the tree, elements cached by pointer are copied
+     * from their streams, which only give const access.
+     *
+     * @tparam OutputIt Output iterator type.
+     * @param out Iterator to the output.
+     * @param count Maximum number of elements to write.
+     * @return `OutputIt` Iterator past the last written element, fewer than
+     * `count` elements are written only if the streams run out.
+     */
+    template <typename OutputIt>
+    OutputIt pop(OutputIt out, std::size_t count);
+
+  private:
+    // Small trivially copyable elements and elements returned by value are
+    // cached by value, the rest as pointers, which stay valid until their
+    // stream is popped.
+    static constexpr bool CACHE_POINTER{
+        std::is_lvalue_reference_v<
+            decltype(std::declval<const Stream&>().front())> &&
+        !(std::is_trivially_copyable_v<Value> &&
+          sizeof(Value) <= 2 * sizeof(void*))};
+    using Key = std::conditional_t<CACHE_POINTER, const Value*, Value>;
+
+    struct Node
+    {
+        Key key;
+        std::size_t stream;
+        bool exhausted;
+    };
+
+    // Node for the next element of a stream.
+    Node head(std::size_t stream) const;
+
+    // Whether node `a` wins a match against node `b`.
+    bool beats(const Node& a, const Node& b) const;
+
+    static const Value& value(const Key& key);
+
+    Stream* m_Streams;
+    std::size_t m_K;
+    Compare m_Comp;
+    // Loser of the match played at each inner node, winner at index 0.
+    std::vector<Node> m_Tree;
+};
+
+/**
+ * @brief Merge sorted ranges into one sorted output.
+ *
+ * @details Merges `k` ranges, each sorted by `comp`, with a
+ * `sort::LoserTree` in `O(n log k)` comparisons for `n` elements in total,
+ * instead of concatenating and sorting them again in `O(n log n)`. Elements
+ * are copied, the inputs are not modified. The merge is stable, equal
+ * elements keep the order of their ranges. The output must not overlap the
+ * inputs.
+ *
+ * Example usage:
+ * @code
+ * std::vector<std::pair<const int*, const int*>> shards;
+ * for (const std::vector<int>& shard : sortedShards)
+ * {
+ *     shards.emplace_back(shard.data(), shard.data() + shard.size());
+ * }
+ * std::vector<int> merged(total);
+ * sort::kWayMerge(shards, merged.begin());
+ * @endcode
+ *
+ * @tparam InputIt Input iterator type.
+ * @tparam OutputIt Output iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param runs Pairs of iterators to the first and one past the last element
+ * of each sorted range.
+ * @param out Iterator to the output.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ * @return `OutputIt` Iterator past the last written element.
+ */
+template <typename InputIt, typename OutputIt, typename Compare = std::less<>>
+OutputIt kWayMerge(const std::vector<std::pair<InputIt, InputIt>>& runs,
+                   OutputIt out, Compare comp = Compare{});
+} // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief Stream over a range of elements.
+ *
+ * @tparam InputIt Input iterator type.
+ */
+template <typename InputIt>
+struct RangeStream
+{
+    bool empty() const
+    {
+        return first == last;
+    }
+
+    decltype(auto) front() const
+    {
+        return *first;
+    }
+
+    void pop()
+    {
+        ++first;
+    }
+
+    InputIt first;
+    InputIt last;
+};
+} // namespace sort_impl
+
+// ------- Loser Tree -----------------------------
+
+template <typename Stream, typename Compare>
+sort::LoserTree<Stream, Compare>::LoserTree(Stream* first, Stream* last,
+                                            Compare comp)
+    : m_Streams(first), m_K(static_cast<std::size_t>(last - first)),
+      m_Comp(comp)
+{
+    // Leaves are the streams at positions k..2k-1 of an implicit complete
+    // binary tree, inner node p has children 2p and 2p + 1. Winners are
+    // played up from the leaves, losers stay at the nodes.
+    std::vector<Node> winners(2 * m_K);
+    for (std::size_t i{0}; i < m_K; ++i)
+    {
+        winners[m_K + i] = head(i);
+    }
+    m_Tree.resize(std::max<std::size_t>(m_K, 1));
+    if (m_K == 0)
+    {
+        return;
+    }
+    for (std::size_t node{m_K - 1}; node > 0; --node)
+    {
+        Node& left{winners[2 * node]};
+        Node& right{winners[2 * node + 1]};
+        bool leftWins{beats(left, right)};
+        m_Tree[node] = std::move(leftWins ? right : left);
+        winners[node] = std::move(leftWins ? left : right);
+    }
+    // Also for a single stream, whose leaf is at position 1.
+    m_Tree[0] = std::move(winners[1]);
+}
+
+template <typename Stream, typename Compare>
+typename sort::LoserTree<Stream, Compare>::Node
+sort::LoserTree<Stream, Compare>::head(std::size_t stream) const
+{
+    Node node{Key{}, stream, m_Streams[stream].empty()};
+    if (!node.exhausted)
+    {
+        if constexpr (CACHE_POINTER)
+        {
+            node.key = &m_Streams[stream].front();
+        }
+        else
+        {
+            node.key = m_Streams[stream].front();
+        }
+    }
+    return node;
+}
+
+template <typename Stream, typename Compare>
+const typename sort::LoserTree<Stream, Compare>::Value&
+sort::LoserTree<Stream, Compare>::value(const Key& key)
+{
+    if constexpr (CACHE_POINTER)
+    {
+        return *key;
+    }
+    else
+    {
+        return key;
+    }
+}
+
+template <typename Stream, typename Compare>
+bool sort::LoserTree<Stream, Compare>::beats(const Node& a,
+                                             const Node& b) const
+{
+    // Exhausted streams lose every match, ties go to the lower stream index.
+    // The second comparison is only needed if `a` does not go first, picking
+    // the comparison by index instead would add an unpredictable branch.
+    if (a.exhausted || b.exhausted)
+    {
+        return b.exhausted;
+    }
+    return m_Comp(value(a.key), value(b.key)) ||
+           (!m_Comp(value(b.key), value(a.key)) && a.stream < b.stream);
+}
+
+template <typename Stream, typename Compare>
+void sort::LoserTree<Stream, Compare>::pop()
+{
+    std::size_t stream{m_Tree[0].stream};
+    m_Streams[stream].pop();
+    Node winner{head(stream)};
+    for (std::size_t node{(m_K + stream) / 2}; node > 0; node /= 2)
+    {
+        if (beats(m_Tree[node], winner))
+        {
+            std::swap(m_Tree[node], winner);
+        }
+    }
+    m_Tree[0] = std::move(winner);
+}
+
+template <typename Stream, typename Compare>
+template <typename OutputIt>
+OutputIt sort::LoserTree<Stream, Compare>::pop(OutputIt out,
+                                               std::size_t count)
+{
+    for (; count > 0 && !empty(); --count)
+    {
+        if constexpr (CACHE_POINTER)
+        {
+            *out = front();
+        }
+        else
+        {
+            // `pop()` refills the root from the stream without reading it.
+            *out = std::move(m_Tree[0].key);
+        }
+        ++out;
+        pop();
+    }
+    return out;
+}
+
+// ------- K-Way Merge -----------------------------
+
+template <typename InputIt, typename OutputIt, typename Compare>
+OutputIt sort::kWayMerge(const std::vector<std::pair<InputIt, InputIt>>& runs,
+                         OutputIt out, Compare comp)
+{
+    std::vector<sort_impl::RangeStream<InputIt>> streams;
+    streams.reserve(runs.size());
+    for (const auto& [first, last] : runs)
+    {
+        streams.push_back({first, last});
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    using Counted = std::remove_reference_t<decltype(counted)>;
+    sort::LoserTree<sort_impl::RangeStream<InputIt>, Counted> tree(
+        streams.data(), streams.data() + streams.size(), counted);
+    return tree.pop(out, std::numeric_limits<std::size_t>::max());
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/Sorting.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Partially sort a range so that the n-th element is in place.
+ *
+ * @details After the call `*nth` is the element that would be there if the
+ * whole range was sorted, no element before it goes after it and no element
+ * after it goes before it. Implemented as introselect: quick select with the
+ * pivot selection and three-way partitioning of `sort::quickSort`, which
+ * only continues into the part that contains `nth`. Expected `O(n)`, when
+ * partitions get unbalanced for more than `2 * log2(n)` rounds the rest is
+ * done by `sort::partialSort`, so the worst case is `O(n log n)`.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> values{5, 1, 4, 2, 3};
+ * sort::nthElement(values.begin(), values.begin() + 2, values.end());
+ * // values[2] == 3
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param nth Iterator to the element to put in place.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void nthElement(RandomIt first, RandomIt nth, RandomIt last,
+                Compare comp = Compare{});
+
+/**
+ * @brief Sort the first elements of a range.
+ *
+ * @details After the call `[first, middle)` holds the `middle - first`
+ * elements that go first, in sorted order. The order of the rest is
+ * unspecified. Keeps a heap of `middle - first` elements built with the heap
+ * sort machinery and replaces its root whenever a better element is found,
+ * then sorts the heap. Runs in `O(n log k)` for `k = middle - first`. Not
+ * stable.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> values{5, 1, 4, 2, 3};
+ * sort::partialSort(values.begin(), values.begin() + 2, values.end());
+ * // values starts with {1, 2}
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param middle Iterator to one past the last element to sort.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last,
+                 Compare comp = Compare{});
+
+/**
+ * @brief Streaming top-k selection.
+ *
+ * @details Consumes values one by one or in chunks and keeps the `k` values
+ * that go first in the order of `comp`, by default (`std::greater<>`) the
+ * `k` largest. Memory is bounded by `k` values no matter how many are
+ * pushed. Values are kept in a heap whose root is the worst kept value, most
+ * values are rejected by a single comparison with it, the others cost
+ * `O(log k)`.
+ *
+ * Example usage:
+ * @code
+ * sort::TopK<double> top(100);
+ * while (readChunk(chunk))
+ * {
+ *     top.push(chunk.begin(), chunk.end());
+ * }
+ * std::vector<double> largest{top.values()};
+ * @endcode
+ *
+ * @tparam T Type of the values.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ */
+template <typename T, typename Compare = std::greater<>>
+class TopK
+{
+  public:
+    /**
+     * @brief Construct a new TopK object.
+     *
+     * @param k Number of values to keep.
+     * @param comp Compare function, returns `true` if first argument goes
+     * first.
+     */
+    explicit TopK(std::size_t k, Compare comp = Compare{});
+
+    /**
+     * @brief Offer a value.
+     *
+     * @param value Value kept if it is among the best `k` so far.
+     */
+    void push(const T& value);
+
+    /**
+     * @brief Offer a chunk of values.
+     *
+     * @tparam InputIt Input iterator type.
+     * @param first Iterator to the first value.
+     * @param last Iterator to one past the last value.
+     */
+    template <typename InputIt>
+    void push(InputIt first, InputIt last);
+
+    /**
+     * @brief Get the kept values.
+     *
+     * @return `std::vector<T>` Best values so far, best first.
+     */
+    std::vector<T> values() const;
+
+    /**
+     * @brief Get number of kept values.
+     *
+     * @return `std::size_t` Number of kept values, at most `k`.
+     */
+    std::size_t size() const
+    {
+        return m_Heap.size();
+    }
+
+    /**
+     * @brief Drop all kept values.
+     *
+     */
+    void clear()
+    {
+        m_Heap.clear();
+    }
+
+  private:
+    std::size_t m_K;
+    Compare m_Comp;
+    std::vector<T> m_Heap;
+};
+} // namespace sort
+
+namespace sort_impl
+{
+
+template <typename RandomIt, typename Compare>
+void introSelect(RandomIt first, RandomIt nth, RandomIt last, int depthLimit,
+                 Compare& comp);
+} // namespace sort_impl
+
+// ------- Nth Element -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::nthElement(RandomIt first, RandomIt nth, RandomIt last,
+                      Compare comp)
+{
+    if (nth == last)
+    {
+        return;
+    }
+    int depthLimit{0};
+    for (auto n{last - first}; n > 1; n /= 2)
+    {
+        depthLimit += 2;
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::introSelect(first, nth, last, depthLimit, counted);
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::introSelect(RandomIt first, RandomIt nth, RandomIt last,
+                            int depthLimit, Compare& comp)
+{
+    while (last - first > INSERTION_SORT_THRESHOLD)
+    {
+        if (depthLimit == 0)
+        {
+            // Bad pivots, a heap of the elements up to nth bounds the rest.
+            sort::partialSort(first, nth + 1, last, comp);
+            return;
+        }
+        --depthLimit;
+
+        sort_impl::selectPivot(first, last, comp);
+        auto [equalFirst, equalLast] = sort_impl::partition(first, last, comp);
+        if (nth < equalFirst)
+        {
+            last = equalFirst;
+        }
+        else if (nth >= equalLast)
+        {
+            first = equalLast;
+        }
+        else
+        {
+            // nth is equal to the pivot, which is in place.
+            return;
+        }
+    }
+    sort::insertionSort(first, last, comp);
+}
+
+// ------- Partial Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::partialSort(RandomIt first, RandomIt middle, RandomIt last,
+                       Compare comp)
+{
+    auto k{middle - first};
+    if (k == 0)
+    {
+        return;
+    }
+    // The root of the heap is the worst of the best k elements seen so far.
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::makeHeap(first, k, counted);
+    for (RandomIt it{middle}; it != last; ++it)
+    {
+        if (counted(*it, *first))
+        {
+            sort_impl::iterSwap(it, first);
+            sort_impl::heapify(first, k, decltype(k){0}, counted);
+        }
+    }
+    sort_impl::sortHeap(first, k, counted);
+}
+
+// ------- Top K -----------------------------
+
+template <typename T, typename Compare>
+sort::TopK<T, Compare>::TopK(std::size_t k, Compare comp)
+    : m_K(k), m_Comp(comp)
+{
+    m_Heap.reserve(k);
+}
+
+template <typename T, typename Compare>
+void sort::TopK<T, Compare>::push(const T& value)
+{
+    using Difference = typename std::vector<T>::difference_type;
+
+    auto&& counted{sort_impl::countingCompare(m_Comp)};
+    if (m_Heap.size() < m_K)
+    {
+        // Collect the first k values unordered, then heapify them at once.
+        m_Heap.push_back(value);
+        if (m_Heap.size() == m_K)
+        {
+            sort_impl::makeHeap(m_Heap.begin(), static_cast<Difference>(m_K),
+                                counted);
+        }
+    }
+    else if (m_K > 0 && counted(value, m_Heap.front()))
+    {
+        m_Heap.front() = value;
+        sort_impl::heapify(m_Heap.begin(), static_cast<Difference>(m_K),
+                           Difference{0}, counted);
+    }
+}
+
+template <typename T, typename Compare>
+template <typename InputIt>
+void sort::TopK<T, Compare>::push(InputIt first, InputIt last)
+{
+    for (; first != last; ++first)
+    {
+        push(*first);
+    }
+}
+
+template <typename T, typename Compare>
+std::vector<T> sort::TopK<T, Compare>::values() const
+{
+    using Difference = typename std::vector<T>::difference_type;
+
+    std::vector<T> result{m_Heap};
+    Compare comp{m_Comp};
+    auto&& counted{sort_impl::countingCompare(comp)};
+    auto n{static_cast<Difference>(result.size())};
+    if (result.size() < m_K)
+    {
+        sort_impl::makeHeap(result.begin(), n, counted);
+    }
+    sort_impl::sortHeap(result.begin(), n, counted);
+    return result;
+}
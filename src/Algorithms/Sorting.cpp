@@ -1,5 +1,11 @@
 #include "Algorithms/Sorting.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Algorithms/SortingNetworks.hpp"
+
 void sort::swapElements(int* first, int* second)
 {
 
@@ -8,187 +14,126 @@ void sort::swapElements(int* first, int* second)
     *second = tmp;
 }
 
-// ------- Bubble Sort -----------------------------
+// Integer array entry points forward to the generic implementations in
+// Sorting.hpp, they are instantiated once here for `int*`. Merge sort is the
+// exception, it runs on the SIMD kernels from SortingNetworks.hpp.
 
-void sort::bubbleSort(int* numbers, int n)
+void sort::bubbleSort(int* numbers, std::size_t n)
 {
-    for (int i{0}; i < n - 1; ++i)
-    {
-        for (int j{i + 1}; j < n; ++j)
-        {
-            // Swap numbers if i-th is larger than j-th
-            if (numbers[i] > numbers[j])
-            {
-                swapElements(&numbers[i], &numbers[j]);
-            }
-        }
-    }
+    bubbleSort(numbers, numbers + n);
 }
 
-// ------- Selection Sort -----------------------------
-
-void sort::selectionSort(int* numbers, int n)
+void sort::selectionSort(int* numbers, std::size_t n)
 {
-    int smallest_idx;
-    for (int i{0}; i < n - 1; ++i)
-    {
-        smallest_idx = i;
-        for (int j{i + 1}; j < n; ++j)
-        {
-            // Scan searching for the smallest number.
-            if (numbers[smallest_idx] > numbers[j])
-            {
-                smallest_idx = j;
-            }
-        }
-        if (smallest_idx != i)
-        {
-            // Insert the value in the correct place.
-            swapElements(&numbers[i], &numbers[smallest_idx]);
-        }
-    }
+    selectionSort(numbers, numbers + n);
 }
 
-// ------- Merge Sort -----------------------------
-
-static void mergeSort(int* numbers, int* helper, int low, int high);
-static void merge(int* numbers, int* helper, int low, int middle, int high);
-
-void sort::mergeSort(int* numbers, int n)
+void sort::mergeSort(int* numbers, std::size_t n)
 {
-    int* helper{new int[n]};
-    ::mergeSort(numbers, helper, 0, n - 1);
-    delete[] helper;
-}
-
-static void mergeSort(int* numbers, int* helper, int low, int high)
-{
-    if (low >= high)
+    if (n < 2)
     {
         return;
     }
-    int middle{low + (high - low) / 2};
-    mergeSort(numbers, helper, low, middle);
-    mergeSort(numbers, helper, middle + 1, high);
-    merge(numbers, helper, low, middle, high);
+    std::vector<int> buffer(n);
+    sort_impl::countScratch(n * sizeof(int));
+    mergeSort(numbers, n, buffer.data());
 }
 
-static void merge(int* numbers, int* helper, int low, int middle, int high)
+void sort::mergeSort(int* numbers, std::size_t n, int* buffer)
 {
-    // Copy content of the array to helper array.
-    // Nomally, left and right subarrays would be created. Left of range
-    // [low,middle], right of range [middle+1,high]. Helper array allows to skip
-    // creating additional arrays in mergeSort functions so the algorithm takes
-    // O(n) extra space.
-    for (int i{low}; i <= high; ++i)
+    // Bottom-up merge sort on SIMD kernels, leaves are sorted with sorting
+    // networks and passes use bitonic merges. The pass count is made even so
+    // the result ends up in numbers.
+    std::size_t size{n};
+    std::size_t width{NETWORK_SORT_MAX};
+    int passes{0};
+    for (std::size_t w{width}; w < size; w *= 2)
     {
-        helper[i] = numbers[i];
+        ++passes;
+    }
+    if (passes % 2 != 0)
+    {
+        width /= 2;
     }
 
-    int left{low};
-    int right{middle + 1};
-    int current{low};
-
-    while (left <= middle && right <= high)
+    for (std::size_t low{0}; low < size; low += width)
     {
-        if (helper[left] <= helper[right])
-        {
-            numbers[current++] = helper[left++];
-        }
-        else
-        {
-            numbers[current++] = helper[right++];
-        }
+        networkSort(numbers + low, std::min(width, size - low));
     }
 
-    // Copy the leftovers from the left side.
-    // No need to copy from the right size because it's already there
-    // helper content was taken from numbers array at the beginning.
-    while (left <= middle)
+    int* source{numbers};
+    int* destination{buffer};
+    for (; width < size; width *= 2)
     {
-        numbers[current++] = helper[left++];
+        for (std::size_t low{0}; low < size; low += 2 * width)
+        {
+            std::size_t middle{std::min(low + width, size)};
+            std::size_t high{std::min(low + 2 * width, size)};
+            bitonicMerge(source + low, middle - low, source + middle,
+                         high - middle, destination + low);
+        }
+        sort_impl::countMoves(size);
+        std::swap(source, destination);
     }
 }
 
-// ------- Quick Sort -----------------------------
+void sort::timSort(int* numbers, std::size_t n)
+{
+    timSort(numbers, numbers + n);
+}
 
-static void quickSort(int* numbers, int start, int end);
-static int partition(int* numbers, int start, int end);
+void sort::parallelMergeSort(int* numbers, std::size_t n,
+                             unsigned threads)
+{
+    parallelMergeSort(numbers, numbers + n, threads);
+}
 
-void sort::quickSort(int* numbers, int n)
+void sort::insertionSort(int* numbers, std::size_t n)
 {
-    ::quickSort(numbers, 0, n - 1);
+    insertionSort(numbers, numbers + n);
 }
 
-void quickSort(int* numbers, int start, int end)
+void sort::quickSort(int* numbers, std::size_t n)
 {
-    if (start >= end)
-    {
-        return;
-    }
-    int pivotIdx{partition(numbers, start, end)};
-    quickSort(numbers, start, pivotIdx - 1);
-    quickSort(numbers, pivotIdx + 1, end);
+    quickSort(numbers, numbers + n);
 }
 
-int partition(int* numbers, int start, int end)
+void sort::pdqSort(int* numbers, std::size_t n)
 {
-    int pivot{numbers[end]};
-    int left{start - 1};
-    int right{start};
-    while (right <= end)
-    {
-        if (numbers[right] < pivot)
-        {
-            ++left;
-            sort::swapElements(&numbers[left], &numbers[right]);
-        }
-        ++right;
-    }
-    ++left;
-    sort::swapElements(&numbers[left], &numbers[end]);
+    pdqSort(numbers, numbers + n);
+}
 
-    return left;
+void sort::heapSort(int* numbers, std::size_t n)
+{
+    heapSort(numbers, numbers + n);
 }
 
-// ------- Heap Sort -----------------------------
+void sort::radixSort(int* numbers, std::size_t n)
+{
+    radixSort(numbers, numbers + n);
+}
 
-static void heapify(int* numbers, int n, int index);
+void sort::radixSort(int64_t* numbers, std::size_t n)
+{
+    radixSort(numbers, numbers + n);
+}
 
-void sort::heapSort(int* numbers, int n)
+void sort::radixSort(uint64_t* numbers, std::size_t n)
 {
-    for (int i{n / 2 - 1}; i >= 0; --i)
-    {
-        // Heapify subtrees starting from root of the "last" element.
-        heapify(numbers, n, i);
-    }
+    radixSort(numbers, numbers + n);
+}
 
-    for (int i{n - 1}; i >= 0; --i)
-    {
-        // Max heap the largest element is the root.
-        sort::swapElements(&numbers[0], &numbers[i]);
-        // Heapify reduced range of the array.
-        heapify(numbers, i, 0);
-    }
+void sort::radixSort(float* numbers, std::size_t n)
+{
+    radixSort(numbers, numbers + n);
 }
 
-static void heapify(int* numbers, int n, int index)
+void sort::radixSort(double* numbers, std::size_t n)
 {
-    int largest{index};
-    int leftChild{2 * index + 1};
-    int rightChild{2 * index + 2};
+    radixSort(numbers, numbers + n);
+}
 
-    if (leftChild < n && numbers[leftChild] > numbers[largest])
-    {
-        largest = leftChild;
-    }
-    if (rightChild < n && numbers[rightChild] > numbers[largest])
-    {
-        largest = rightChild;
-    }
-    if (largest != index)
-    {
-        sort::swapElements(&numbers[largest], &numbers[index]);
-        heapify(numbers, n, largest);
-    }
+void sort::parallelRadixSort(int* numbers, std::size_t n, unsigned threads)
+{
+    parallelRadixSort(numbers, numbers + n, threads);
 }
@@ -1,15 +1,338 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/SortingStats.hpp"
+
 namespace sort
 {
 
+/**
+ * @brief Bubble sort algorithm for a range of elements.
+ *
+ * @details Works with any random access iterator. Elements are ordered
+ * according to `comp`, which defaults to ascending order (`operator<`).
+ *
+ * Example usage:
+ * @code
+ * std::vector<double> values{3.0, 1.0, 2.0};
+ * sort::bubbleSort(values.begin(), values.end());
+ * sort::bubbleSort(values.begin(), values.end(), std::greater<>{});
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Selection sort algorithm for a range of elements.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Merge sort algorithm for a range of elements.
+ *
+ * @details The sort is stable. Allocates a helper buffer of the range size,
+ * so the element type has to be default constructible and movable. Use the
+ * overload taking a scratch buffer to avoid the allocation.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void mergeSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Merge sort algorithm for a range of elements using scratch buffer.
+ *
+ * @details Iterative bottom-up merge sort. Runs of `sort_impl::MERGE_SORT_RUN`
+ * elements are sorted with insertion sort, then merged pairwise with every
+ * pass moving the data between the range and the buffer. The buffer is only
+ * grown when shorter than the range, so reusing it for a series of sorts
+ * makes them allocation free. The sort is stable.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> buffer;
+ * for (std::vector<int>& batch : batches)
+ * {
+ *     sort::mergeSort(batch.begin(), batch.end(), buffer);
+ * }
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam T Type of the sorted values.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param buffer Scratch buffer, resized to the range size if shorter.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename T, typename Compare = std::less<>>
+void mergeSort(RandomIt first, RandomIt last, std::vector<T>& buffer,
+               Compare comp = Compare{});
+
+/**
+ * @brief Timsort, adaptive merge sort for partially sorted ranges.
+ *
+ * @details Splits the range into natural runs: ascending ones are kept and
+ * strictly descending ones reversed, runs shorter than a minimum length
+ * (32-64 elements) are extended with binary insertion sort. Runs are merged
+ * following the Timsort stack invariants, and merges switch to galloping
+ * (exponential search) when one run keeps winning, so long blocks are moved
+ * at once. Sorted or reversed input takes `n - 1` comparisons and a sorted
+ * range with a short unsorted tail stays close to `O(n)`, worst case is
+ * `O(n log n)`. The sort is stable and uses a buffer of at most `n / 2`
+ * elements.
+ *
+ * Throws `std::invalid_argument` when the compare function is detected not
+ * to be a strict weak ordering.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void timSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Multithreaded merge sort algorithm for a range of elements.
+ *
+ * @details The range is split in halves sorted on separate threads until the
+ * thread budget is used up or the halves get shorter than
+ * `sort_impl::PARALLEL_GRAIN_SIZE`, those are sorted with the sequential merge
+ * sort. Merges are parallel too: the larger input is split in the middle, the
+ * other one at the matching position found by binary search, and both halves
+ * are merged concurrently, so the last merge does not run on a single thread.
+ *
+ * The sort is stable. The compare function is called concurrently from
+ * several threads and must be safe to use that way.
+ *
+ * Example usage:
+ * @code
+ * std::vector<double> values(1 << 24);
+ * sort::parallelMergeSort(values.begin(), values.end(), 8);
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param threads Maximum number of threads, `0` uses all hardware threads.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallelMergeSort(RandomIt first, RandomIt last, unsigned threads = 0,
+                       Compare comp = Compare{});
+
+/**
+ * @brief Insertion sort algorithm for a range of elements.
+ *
+ * @details The sort is stable and runs in `O(n)` on sorted input, which
+ * makes it the best choice for short or almost sorted ranges.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Quick sort algorithm for a range of elements.
+ *
+ * @details Implemented as introsort. The pivot is a median of three (ninther
+ * for large ranges), keys equal to the pivot are grouped by three-way
+ * partitioning and excluded from further recursion, short ranges are finished
+ * with insertion sort. When recursion gets deeper than `2 * log2(n)` the range
+ * is handed over to heap sort, so the worst case is `O(n log n)` and the stack
+ * depth is `O(log n)`. The sort is not stable.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void quickSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Pattern-defeating quick sort for a range of elements.
+ *
+ * @details Quick sort with branchless block partitioning (BlockQuicksort):
+ * elements on the wrong side of the pivot are found in blocks of
+ * `PARTITION_BLOCK` and their offsets are recorded without data dependent
+ * branches, then swapped pairwise, so random input causes no branch
+ * mispredictions in the partition loop. On top of that the pdqsort
+ * heuristics are used:
+ * - a highly unbalanced partition swaps a few elements around the pivot to
+ *   break up patterns, after `log2(n)` such partitions the range is handed
+ *   over to heap sort,
+ * - a partition that did not move any element is finished with an insertion
+ *   sort that gives up after a few moves, so sorted and reversed input takes
+ *   linear time,
+ * - a pivot equal to the previous one puts all equal keys to the left in
+ *   one pass, so few unique keys take `O(n * k)`.
+ *
+ * Not stable. Worst case `O(n log n)`.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> values{3, 1, 2};
+ * sort::pdqSort(values.begin(), values.end());
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void pdqSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Heap sort algorithm for a range of elements.
+ *
+ * @details Builds a binary max heap and pops its root to the end of the
+ * range until the heap is empty. Sifting moves a hole instead of swapping
+ * elements and pops use Floyd's bottom-up variant: the hole left by the root
+ * walks down to a leaf along the larger children and the last heap element
+ * is sifted up from there. It usually belongs near the bottom, so this takes
+ * about half the comparisons of a top-down sift. `O(n log n)` in the worst
+ * case, no extra memory, not stable.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief Heap sort algorithm with a d-ary heap.
+ *
+ * @details Same as `sort::heapSort`, but every node has `Arity` children.
+ * The heap is `log2(Arity)` times shallower and the children of a node are
+ * adjacent, with `Arity = 4` and 4-byte keys a level of a sift touches a
+ * single cache line. Pays off for large ranges that do not fit into cache.
+ *
+ * Example usage:
+ * @code
+ * std::vector<int> values{3, 1, 2};
+ * sort::heapSort<4>(values.begin(), values.end());
+ * @endcode
+ *
+ * @tparam Arity Number of children of a heap node, at least 2.
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param comp Compare function, returns `true` if first argument goes first.
+ */
+template <int Arity, typename RandomIt, typename Compare = std::less<>>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare{});
+
+/**
+ * @brief LSD radix sort for a range of integers or floating point numbers.
+ *
+ * @details Sorts by 8-bit digits, least significant first, in ascending
+ * order. Signed values are handled by flipping the sign bit of the key,
+ * `float` and `double` by an order preserving transform of their bits, with
+ * `-0.0` before `0.0` and NaN values last. All digit histograms are computed
+ * in a single pass over the input before any scattering and passes where
+ * every key has the same digit are skipped, so e.g. 64-bit keys below `2^16`
+ * take only two scatter passes. The sort is stable, runs in
+ * `O(n * sizeof(T))` and allocates a buffer of the range size.
+ *
+ * Example usage:
+ * @code
+ * std::vector<uint64_t> ids{42, 7, 1ULL << 40};
+ * sort::radixSort(ids.begin(), ids.end());
+ * std::vector<float> scores{0.5f, -1.0f, 2.0f};
+ * sort::radixSort(scores.begin(), scores.end());
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator to an integral or floating point
+ * type.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ */
+template <typename RandomIt>
+void radixSort(RandomIt first, RandomIt last);
+
+/**
+ * @brief Multithreaded LSD radix sort for a range of integers or floating
+ * point numbers.
+ *
+ * @details Same order and digit passes as `sort::radixSort`. Every thread
+ * owns a contiguous chunk of the range and counts the digits of its chunk
+ * into its own histogram. A prefix sum over all histograms, bucket by bucket
+ * and thread by thread within a bucket, gives every thread its own output
+ * offsets, so threads scatter without synchronization and the sort stays
+ * stable. Scattered elements are first collected in a small buffer per
+ * bucket, one cache line each, and written out a full line at a time
+ * (software write combining), so the 256 output streams of a thread do not
+ * evict each other from the cache. Ranges too short to split are sorted by
+ * `sort::radixSort`.
+ *
+ * Example usage:
+ * @code
+ * std::vector<uint64_t> keys(1 << 28);
+ * sort::parallelRadixSort(keys.begin(), keys.end(), 8);
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator to an integral or floating point
+ * type.
+ * @param first Iterator to the first element.
+ * @param last Iterator to one past the last element.
+ * @param threads Maximum number of threads, `0` uses all hardware threads.
+ */
+template <typename RandomIt>
+void parallelRadixSort(RandomIt first, RandomIt last, unsigned threads = 0);
+
 /**
  * @brief Bubble sort algorithm for an array of integers.
  *
  * @param numbers Pointer to arrray of integers.
  * @param n Number of elements in the array.
  */
-void bubbleSort(int* numbers, int n);
+void bubbleSort(int* numbers, std::size_t n);
 
 /**
  * @brief Selection sort algorithm for an array of integers.
@@ -17,15 +340,55 @@ void bubbleSort(int* numbers, int n);
  * @param numbers Pointer to array of integers.
  * @param n Number of elements in the array.
  */
-void selectionSort(int* numbers, int n);
+void selectionSort(int* numbers, std::size_t n);
 
 /**
  * @brief Merge sort algorithm for an array of integers.
  *
+ * @details Leaves are sorted with `sort::networkSort` and runs are merged with
+ * `sort::bitonicMerge`, both use SIMD instructions when available.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void mergeSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Merge sort algorithm for an array of integers using scratch buffer.
+ *
+ * @details Same as `sort::mergeSort(int*, std::size_t)` without allocating
+ * memory.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ * @param buffer Pointer to scratch array of at least `n` integers.
+ */
+void mergeSort(int* numbers, std::size_t n, int* buffer);
+
+/**
+ * @brief Timsort algorithm for an array of integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void timSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Multithreaded merge sort algorithm for an array of integers.
+ *
  * @param numbers Pointer to array of integers.
  * @param n Number of elements in the array.
+ * @param threads Maximum number of threads, `0` uses all hardware threads.
  */
-void mergeSort(int* numbers, int n);
+void parallelMergeSort(int* numbers, std::size_t n, unsigned threads = 0);
+
+/**
+ * @brief Insertion sort algorithm for an array of integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void insertionSort(int* numbers, std::size_t n);
 
 /**
  * @brief Quick sort algorithm for an array of integers.
@@ -33,7 +396,15 @@ void mergeSort(int* numbers, int n);
  * @param numbers Pointer to array of integers.
  * @param n Number of elements in the array.
  */
-void quickSort(int* numbers, int n);
+void quickSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Pattern-defeating quick sort algorithm for an array of integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void pdqSort(int* numbers, std::size_t n);
 
 /**
  * @brief Heap sort algorithm for an array of integers.
@@ -41,7 +412,60 @@ void quickSort(int* numbers, int n);
  * @param numbers Pointer to array of integers.
  * @param n Number of elements in the array.
  */
-void heapSort(int* numbers, int n);
+void heapSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Radix sort algorithm for an array of integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void radixSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Radix sort algorithm for an array of 64-bit integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void radixSort(int64_t* numbers, std::size_t n);
+
+/**
+ * @brief Radix sort algorithm for an array of unsigned 64-bit integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void radixSort(uint64_t* numbers, std::size_t n);
+
+/**
+ * @brief Radix sort algorithm for an array of floats.
+ *
+ * @details Ascending order, `-0.0` goes before `0.0` and NaN values go last.
+ *
+ * @param numbers Pointer to array of floats.
+ * @param n Number of elements in the array.
+ */
+void radixSort(float* numbers, std::size_t n);
+
+/**
+ * @brief Radix sort algorithm for an array of doubles.
+ *
+ * @details Ascending order, `-0.0` goes before `0.0` and NaN values go last.
+ *
+ * @param numbers Pointer to array of doubles.
+ * @param n Number of elements in the array.
+ */
+void radixSort(double* numbers, std::size_t n);
+
+/**
+ * @brief Multithreaded radix sort algorithm for an array of integers.
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ * @param threads Maximum number of threads, `0` uses all hardware threads.
+ */
+void parallelRadixSort(int* numbers, std::size_t n, unsigned threads = 0);
 
 /**
  * @brief Helper function to swap two elements.
@@ -51,3 +475,2105 @@ void heapSort(int* numbers, int n);
  */
 void swapElements(int* first, int* second);
 } // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief Merge sort runs of this size are presorted with insertion sort.
+ *
+ */
+constexpr int MERGE_SORT_RUN{32};
+
+template <typename RandomIt, typename BufferIt, typename Compare>
+void mergeSort(RandomIt first, RandomIt last, BufferIt buffer, Compare& comp);
+
+template <typename SourceIt, typename DestinationIt, typename Compare>
+void mergePass(SourceIt source,
+               typename std::iterator_traits<SourceIt>::difference_type n,
+               typename std::iterator_traits<SourceIt>::difference_type width,
+               DestinationIt destination, Compare& comp);
+
+/**
+ * @brief Ranges of at most this size are finished with insertion sort.
+ *
+ */
+constexpr int INSERTION_SORT_THRESHOLD{16};
+
+/**
+ * @brief Ranges larger than this use the ninther to select quick sort pivot.
+ *
+ */
+constexpr int NINTHER_THRESHOLD{128};
+
+/**
+ * @brief Timsort enters galloping mode after this many consecutive wins.
+ *
+ */
+constexpr std::ptrdiff_t MIN_GALLOP{7};
+
+/**
+ * @brief State of a single Timsort call.
+ *
+ * @details Keeps the stack of pending runs, the merge buffer and the adaptive
+ * galloping threshold. Runs are stored as offsets from the range start.
+ *
+ * @tparam RandomIt Random access iterator type.
+ * @tparam Compare Strict weak ordering, `bool(const T&, const T&)`.
+ */
+template <typename RandomIt, typename Compare>
+class TimSort
+{
+  public:
+    /**
+     * @brief Construct a new TimSort object for a range.
+     *
+     * @param first Iterator to the first element.
+     * @param last Iterator to one past the last element.
+     * @param comp Compare function.
+     */
+    TimSort(RandomIt first, RandomIt last, Compare& comp)
+        : m_First{first}, m_Size{last - first}, m_Comp{comp}
+    {
+    }
+
+    /**
+     * @brief Sort the range.
+     *
+     */
+    void run();
+
+  private:
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Index = typename std::iterator_traits<RandomIt>::difference_type;
+
+    struct Run
+    {
+        Index base;
+        Index length;
+    };
+
+    RandomIt m_First;
+    Index m_Size;
+    Compare& m_Comp;
+    Index m_MinGallop{MIN_GALLOP};
+    std::vector<T> m_Buffer;
+    std::vector<Run> m_Runs;
+
+    static Index minRunLength(Index n);
+    Index countRunAndMakeAscending(Index low, Index high);
+    void binaryInsertionSort(Index low, Index high, Index start);
+    void mergeCollapse();
+    void mergeForceCollapse();
+    void mergeAt(std::size_t i);
+    void mergeLow(Index base1, Index length1, Index base2, Index length2);
+    void mergeHigh(Index base1, Index length1, Index base2, Index length2);
+    T* bufferFor(Index length);
+
+    template <typename It>
+    Index gallopLeft(const T& key, It base, Index length, Index hint);
+    template <typename It>
+    Index gallopRight(const T& key, It base, Index length, Index hint);
+};
+
+/**
+ * @brief Ranges shorter than this are sorted and merged by a single thread.
+ *
+ */
+constexpr std::ptrdiff_t PARALLEL_GRAIN_SIZE{1 << 14};
+
+template <typename RandomIt, typename BufferIt, typename Compare>
+void parallelMergeSort(RandomIt first, RandomIt last, BufferIt buffer,
+                       unsigned threads, bool toBuffer, Compare& comp);
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename Compare>
+OutputIt moveMerge(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                   InputIt2 last2, OutputIt out, Compare& comp);
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename Compare>
+void parallelMerge(InputIt1 first1, InputIt1 last1, InputIt2 first2,
+                   InputIt2 last2, OutputIt out, unsigned threads,
+                   Compare& comp);
+
+template <typename RandomIt, typename Compare>
+void introSort(RandomIt first, RandomIt last, int depthLimit, Compare& comp);
+
+template <typename RandomIt, typename Compare>
+void sortThree(RandomIt a, RandomIt b, RandomIt c, Compare& comp);
+
+template <typename RandomIt, typename Compare>
+void selectPivot(RandomIt first, RandomIt last, Compare& comp);
+
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, RandomIt> partition(RandomIt first, RandomIt last,
+                                        Compare& comp);
+
+/**
+ * @brief Number of elements scanned per block by the block partition.
+ *
+ */
+constexpr int PARTITION_BLOCK{64};
+
+/**
+ * @brief Partial insertion sort gives up after this many element moves.
+ *
+ */
+constexpr std::ptrdiff_t PARTIAL_INSERTION_SORT_LIMIT{8};
+
+template <typename RandomIt, typename Compare>
+void pdqSort(RandomIt first, RandomIt last, int badAllowed, bool leftmost,
+             Compare& comp);
+
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, bool> blockPartition(RandomIt first, RandomIt last,
+                                         Compare& comp);
+
+template <typename RandomIt>
+void swapOffsets(RandomIt leftBase, RandomIt rightBase,
+                 const unsigned char* leftOffsets,
+                 const unsigned char* rightOffsets, std::size_t count,
+                 bool useSwaps);
+
+template <typename RandomIt, typename Compare>
+RandomIt partitionEqual(RandomIt first, RandomIt last, Compare& comp);
+
+template <typename RandomIt, typename Compare>
+void unguardedInsertionSort(RandomIt first, RandomIt last, Compare& comp);
+
+template <typename RandomIt, typename Compare>
+bool partialInsertionSort(RandomIt first, RandomIt last, Compare& comp);
+
+template <typename RandomIt>
+void breakPatterns(RandomIt first, RandomIt last);
+
+template <int Arity = 2, typename RandomIt, typename Compare>
+void makeHeap(RandomIt first,
+              typename std::iterator_traits<RandomIt>::difference_type n,
+              Compare& comp);
+
+template <int Arity = 2, typename RandomIt, typename Compare>
+void sortHeap(RandomIt first,
+              typename std::iterator_traits<RandomIt>::difference_type n,
+              Compare& comp);
+
+template <int Arity = 2, typename RandomIt, typename Compare>
+typename std::iterator_traits<RandomIt>::difference_type largestChild(
+    RandomIt first, typename std::iterator_traits<RandomIt>::difference_type n,
+    typename std::iterator_traits<RandomIt>::difference_type child,
+    Compare& comp);
+
+template <int Arity = 2, typename RandomIt, typename Compare>
+void heapify(RandomIt first,
+             typename std::iterator_traits<RandomIt>::difference_type n,
+             typename std::iterator_traits<RandomIt>::difference_type index,
+             Compare& comp);
+
+/**
+ * @brief Number of bits sorted by a single radix sort pass.
+ *
+ */
+constexpr int RADIX_BITS{8};
+
+/**
+ * @brief Number of buckets in a single radix sort pass.
+ *
+ */
+constexpr std::size_t RADIX_BUCKETS{1 << RADIX_BITS};
+
+/**
+ * @brief Order preserving mapping of a value to an unsigned radix key.
+ *
+ * @details Keys compare as unsigned integers in the same order as the values
+ * they were made from. Signed integers get their sign bit flipped so negative
+ * values go first. Floating point values get their sign bit flipped if
+ * positive and all bits flipped if negative, so larger magnitudes of negative
+ * values go first, `-0.0` right before `0.0`. NaN values of either sign map
+ * to the largest key and go last.
+ *
+ * @tparam T Type of the sorted values.
+ */
+template <typename T, typename Enable = void>
+struct RadixKey;
+
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_integral_v<T> &&
+                                    !std::is_same_v<T, bool>>>
+{
+    using type = std::make_unsigned_t<T>;
+
+    static type encode(T value)
+    {
+        auto key{static_cast<type>(value)};
+        if constexpr (std::is_signed_v<T>)
+        {
+            key ^= type{1} << (sizeof(type) * 8 - 1);
+        }
+        return key;
+    }
+};
+
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_floating_point_v<T> &&
+                                    std::numeric_limits<T>::is_iec559 &&
+                                    (sizeof(T) == 4 || sizeof(T) == 8)>>
+{
+    using type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+    static type encode(T value)
+    {
+        constexpr type signBit{type{1} << (sizeof(type) * 8 - 1)};
+        if (value != value)
+        {
+            return ~type{0};
+        }
+        type bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & signBit) != 0 ? ~bits : bits ^ signBit;
+    }
+};
+
+/**
+ * @brief Whether `T` has a radix key, i.e. can be sorted by `sort::radixSort`.
+ *
+ * @tparam T Type of the sorted values.
+ */
+template <typename T, typename Enable = void>
+struct HasRadixKey : std::false_type
+{
+};
+
+template <typename T>
+struct HasRadixKey<T, std::void_t<typename RadixKey<T>::type>>
+    : std::true_type
+{
+};
+
+template <typename RandomIt, typename KeyOf>
+void radixSort(RandomIt first, RandomIt last, KeyOf keyOf);
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf>
+void radixScatter(SourceIt source, std::size_t n, DestinationIt destination,
+                  std::size_t* offsets, int shift, KeyOf& keyOf);
+
+/**
+ * @brief Bytes buffered per bucket before a radix scatter writes them out.
+ *
+ */
+constexpr std::size_t RADIX_WRITE_BUFFER{64};
+
+template <typename RandomIt, typename KeyOf>
+void parallelRadixSort(RandomIt first, RandomIt last, unsigned threads,
+                       KeyOf keyOf);
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf>
+void radixScatterBuffered(SourceIt source, std::size_t n,
+                          DestinationIt destination, std::size_t* offsets,
+                          int shift, KeyOf& keyOf);
+} // namespace sort_impl
+
+// ------- Bubble Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::bubbleSort(RandomIt first, RandomIt last, Compare comp)
+{
+    auto&& counted{sort_impl::countingCompare(comp)};
+    for (RandomIt i{first}; i < last; ++i)
+    {
+        for (RandomIt j{i + 1}; j < last; ++j)
+        {
+            // Swap elements if j-th should go before i-th.
+            if (counted(*j, *i))
+            {
+                sort_impl::iterSwap(i, j);
+            }
+        }
+    }
+}
+
+// ------- Selection Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::selectionSort(RandomIt first, RandomIt last, Compare comp)
+{
+    auto&& counted{sort_impl::countingCompare(comp)};
+    for (RandomIt i{first}; i < last; ++i)
+    {
+        RandomIt smallest{i};
+        for (RandomIt j{i + 1}; j < last; ++j)
+        {
+            // Scan searching for the smallest element.
+            if (counted(*j, *smallest))
+            {
+                smallest = j;
+            }
+        }
+        if (smallest != i)
+        {
+            // Insert the value in the correct place.
+            sort_impl::iterSwap(i, smallest);
+        }
+    }
+}
+
+// ------- Merge Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::mergeSort(RandomIt first, RandomIt last, Compare comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    std::vector<T> buffer;
+    sort::mergeSort(first, last, buffer, comp);
+}
+
+template <typename RandomIt, typename T, typename Compare>
+void sort::mergeSort(RandomIt first, RandomIt last, std::vector<T>& buffer,
+                     Compare comp)
+{
+    static_assert(
+        std::is_same_v<T, typename std::iterator_traits<RandomIt>::value_type>,
+        "Buffer has to hold the sorted value type.");
+
+    auto n{static_cast<std::size_t>(last - first)};
+    if (n < 2)
+    {
+        return;
+    }
+    if (buffer.size() < n)
+    {
+        sort_impl::countScratch(n * sizeof(T));
+        buffer.resize(n);
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::mergeSort(first, last, buffer.begin(), counted);
+}
+
+template <typename RandomIt, typename BufferIt, typename Compare>
+void sort_impl::mergeSort(RandomIt first, RandomIt last, BufferIt buffer,
+                          Compare& comp)
+{
+    auto n{last - first};
+    if (n < 2)
+    {
+        return;
+    }
+
+    // Every merge pass moves the data between the range and the buffer. Runs
+    // start shorter when needed so the number of passes is even and the last
+    // pass lands back in the range without a final copy.
+    auto width{static_cast<decltype(n)>(MERGE_SORT_RUN)};
+    int passes{0};
+    for (auto w{width}; w < n; w *= 2)
+    {
+        ++passes;
+    }
+    if (passes % 2 != 0)
+    {
+        width /= 2;
+    }
+
+    for (auto low{decltype(n){0}}; low < n; low += width)
+    {
+        sort::insertionSort(first + low, first + std::min(low + width, n),
+                            comp);
+    }
+
+    bool inBuffer{false};
+    for (; width < n; width *= 2)
+    {
+        if (inBuffer)
+        {
+            sort_impl::mergePass(buffer, n, width, first, comp);
+        }
+        else
+        {
+            sort_impl::mergePass(first, n, width, buffer, comp);
+        }
+        inBuffer = !inBuffer;
+    }
+}
+
+template <typename SourceIt, typename DestinationIt, typename Compare>
+void sort_impl::mergePass(
+    SourceIt source, typename std::iterator_traits<SourceIt>::difference_type n,
+    typename std::iterator_traits<SourceIt>::difference_type width,
+    DestinationIt destination, Compare& comp)
+{
+    for (decltype(n) low{0}; low < n; low += 2 * width)
+    {
+        auto middle{std::min(low + width, n)};
+        auto high{std::min(low + 2 * width, n)};
+        sort_impl::moveMerge(source + low, source + middle, source + middle,
+                             source + high, destination + low, comp);
+    }
+}
+
+// ------- Tim Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::timSort(RandomIt first, RandomIt last, Compare comp)
+{
+    if (last - first < 2)
+    {
+        return;
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    using Counted = std::remove_reference_t<decltype(counted)>;
+    sort_impl::TimSort<RandomIt, Counted>(first, last, counted).run();
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::run()
+{
+    Index minRun{minRunLength(m_Size)};
+    Index low{0};
+    while (low < m_Size)
+    {
+        Index runLength{countRunAndMakeAscending(low, m_Size)};
+        if (runLength < minRun)
+        {
+            // Extend short natural runs to the minimum length.
+            Index forced{std::min(minRun, m_Size - low)};
+            binaryInsertionSort(low, low + forced, low + runLength);
+            runLength = forced;
+        }
+        m_Runs.push_back({low, runLength});
+        mergeCollapse();
+        low += runLength;
+    }
+    mergeForceCollapse();
+}
+
+template <typename RandomIt, typename Compare>
+typename sort_impl::TimSort<RandomIt, Compare>::Index sort_impl::TimSort<
+    RandomIt, Compare>::minRunLength(Index n)
+{
+    // Take the six most significant bits of n, plus one if any of the
+    // remaining bits is set, so n / minRun is close to a power of two.
+    Index remainder{0};
+    while (n >= 64)
+    {
+        remainder |= n & 1;
+        n >>= 1;
+    }
+    return n + remainder;
+}
+
+template <typename RandomIt, typename Compare>
+typename sort_impl::TimSort<RandomIt, Compare>::Index sort_impl::TimSort<
+    RandomIt, Compare>::countRunAndMakeAscending(Index low, Index high)
+{
+    Index runHigh{low + 1};
+    if (runHigh == high)
+    {
+        return 1;
+    }
+
+    RandomIt a{m_First};
+    if (m_Comp(a[runHigh++], a[low]))
+    {
+        // Descending runs have to be strict, reversing keeps the stability.
+        while (runHigh < high && m_Comp(a[runHigh], a[runHigh - 1]))
+        {
+            ++runHigh;
+        }
+        std::reverse(a + low, a + runHigh);
+    }
+    else
+    {
+        while (runHigh < high && !m_Comp(a[runHigh], a[runHigh - 1]))
+        {
+            ++runHigh;
+        }
+    }
+    return runHigh - low;
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::binaryInsertionSort(Index low,
+                                                                Index high,
+                                                                Index start)
+{
+    RandomIt a{m_First};
+    for (; start < high; ++start)
+    {
+        T pivot{std::move(a[start])};
+        // Insert after equal elements to keep the sort stable.
+        RandomIt position{std::upper_bound(a + low, a + start, pivot, m_Comp)};
+        std::move_backward(position, a + start, a + start + 1);
+        *position = std::move(pivot);
+        sort_impl::countMoves(static_cast<std::uint64_t>(a + start - position) +
+                              2);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::mergeCollapse()
+{
+    // Keep run lengths growing at least as fast as Fibonacci numbers down the
+    // stack, which bounds the stack size and keeps the merges balanced. The
+    // invariant is checked on the top four runs, three are not enough.
+    while (m_Runs.size() > 1)
+    {
+        std::size_t n{m_Runs.size() - 2};
+        if ((n > 0 && m_Runs[n - 1].length <=
+                          m_Runs[n].length + m_Runs[n + 1].length) ||
+            (n > 1 &&
+             m_Runs[n - 2].length <= m_Runs[n - 1].length + m_Runs[n].length))
+        {
+            if (m_Runs[n - 1].length < m_Runs[n + 1].length)
+            {
+                --n;
+            }
+        }
+        else if (m_Runs[n].length > m_Runs[n + 1].length)
+        {
+            break;
+        }
+        mergeAt(n);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::mergeForceCollapse()
+{
+    while (m_Runs.size() > 1)
+    {
+        std::size_t n{m_Runs.size() - 2};
+        if (n > 0 && m_Runs[n - 1].length < m_Runs[n + 1].length)
+        {
+            --n;
+        }
+        mergeAt(n);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::mergeAt(std::size_t i)
+{
+    Index base1{m_Runs[i].base};
+    Index length1{m_Runs[i].length};
+    Index base2{m_Runs[i + 1].base};
+    Index length2{m_Runs[i + 1].length};
+
+    m_Runs[i].length = length1 + length2;
+    m_Runs.erase(m_Runs.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+
+    // Elements of the first run smaller than the start of the second one and
+    // elements of the second run larger than the end of the first one are
+    // already in place.
+    RandomIt a{m_First};
+    Index k{gallopRight(a[base2], a + base1, length1, 0)};
+    base1 += k;
+    length1 -= k;
+    if (length1 == 0)
+    {
+        return;
+    }
+    length2 = gallopLeft(a[base1 + length1 - 1], a + base2, length2,
+                         length2 - 1);
+    if (length2 == 0)
+    {
+        return;
+    }
+
+    // Only the shorter run is moved out to the buffer.
+    sort_impl::countMoves(
+        static_cast<std::uint64_t>(std::min(length1, length2) + length1 +
+                                   length2));
+    if (length1 <= length2)
+    {
+        mergeLow(base1, length1, base2, length2);
+    }
+    else
+    {
+        mergeHigh(base1, length1, base2, length2);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::mergeLow(Index base1,
+                                                     Index length1,
+                                                     Index base2,
+                                                     Index length2)
+{
+    RandomIt a{m_First};
+    T* buffer{bufferFor(length1)};
+    std::move(a + base1, a + base1 + length1, buffer);
+
+    Index cursor1{0};
+    Index cursor2{base2};
+    Index destination{base1};
+    a[destination++] = std::move(a[cursor2++]);
+    if (--length2 == 0)
+    {
+        std::move(buffer, buffer + length1, a + destination);
+        return;
+    }
+    if (length1 == 1)
+    {
+        std::move(a + cursor2, a + cursor2 + length2, a + destination);
+        a[destination + length2] = std::move(buffer[cursor1]);
+        return;
+    }
+
+    Index minGallop{m_MinGallop};
+    bool done{false};
+    while (!done)
+    {
+        Index count1{0};
+        Index count2{0};
+
+        // One element at a time until one run wins consistently.
+        do
+        {
+            if (m_Comp(a[cursor2], buffer[cursor1]))
+            {
+                a[destination++] = std::move(a[cursor2++]);
+                ++count2;
+                count1 = 0;
+                done = --length2 == 0;
+            }
+            else
+            {
+                a[destination++] = std::move(buffer[cursor1++]);
+                ++count1;
+                count2 = 0;
+                done = --length1 == 1;
+            }
+        } while (!done && (count1 | count2) < minGallop);
+
+        // Galloping, move whole blocks until neither run wins by much.
+        while (!done)
+        {
+            count1 = gallopRight(a[cursor2], buffer + cursor1, length1, 0);
+            if (count1 != 0)
+            {
+                std::move(buffer + cursor1, buffer + cursor1 + count1,
+                          a + destination);
+                destination += count1;
+                cursor1 += count1;
+                length1 -= count1;
+                if (length1 <= 1)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            a[destination++] = std::move(a[cursor2++]);
+            if (--length2 == 0)
+            {
+                done = true;
+                break;
+            }
+
+            count2 = gallopLeft(buffer[cursor1], a + cursor2, length2, 0);
+            if (count2 != 0)
+            {
+                std::move(a + cursor2, a + cursor2 + count2, a + destination);
+                destination += count2;
+                cursor2 += count2;
+                length2 -= count2;
+                if (length2 == 0)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            a[destination++] = std::move(buffer[cursor1++]);
+            if (--length1 == 1)
+            {
+                done = true;
+                break;
+            }
+
+            --minGallop;
+            if (count1 < MIN_GALLOP && count2 < MIN_GALLOP)
+            {
+                break;
+            }
+        }
+        if (!done)
+        {
+            // Leaving galloping mode makes it harder to enter again.
+            minGallop = std::max(minGallop, Index{0}) + 2;
+        }
+    }
+    m_MinGallop = std::max(minGallop, Index{1});
+
+    if (length1 == 1)
+    {
+        std::move(a + cursor2, a + cursor2 + length2, a + destination);
+        a[destination + length2] = std::move(buffer[cursor1]);
+    }
+    else if (length1 == 0)
+    {
+        throw std::invalid_argument(
+            "Compare function is not a strict weak ordering!");
+    }
+    else
+    {
+        std::move(buffer + cursor1, buffer + cursor1 + length1,
+                  a + destination);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::TimSort<RandomIt, Compare>::mergeHigh(Index base1,
+                                                      Index length1,
+                                                      Index base2,
+                                                      Index length2)
+{
+    RandomIt a{m_First};
+    T* buffer{bufferFor(length2)};
+    std::move(a + base2, a + base2 + length2, buffer);
+
+    // Merging backwards, cursors point at the last unmerged elements.
+    Index cursor1{base1 + length1 - 1};
+    Index cursor2{length2 - 1};
+    Index destination{base2 + length2 - 1};
+    a[destination--] = std::move(a[cursor1--]);
+    if (--length1 == 0)
+    {
+        std::move(buffer, buffer + length2,
+                  a + (destination - (length2 - 1)));
+        return;
+    }
+    if (length2 == 1)
+    {
+        destination -= length1;
+        cursor1 -= length1;
+        std::move_backward(a + (cursor1 + 1), a + (cursor1 + 1 + length1),
+                           a + (destination + 1 + length1));
+        a[destination] = std::move(buffer[cursor2]);
+        return;
+    }
+
+    Index minGallop{m_MinGallop};
+    bool done{false};
+    while (!done)
+    {
+        Index count1{0};
+        Index count2{0};
+
+        // One element at a time until one run wins consistently.
+        do
+        {
+            if (m_Comp(buffer[cursor2], a[cursor1]))
+            {
+                a[destination--] = std::move(a[cursor1--]);
+                ++count1;
+                count2 = 0;
+                done = --length1 == 0;
+            }
+            else
+            {
+                a[destination--] = std::move(buffer[cursor2--]);
+                ++count2;
+                count1 = 0;
+                done = --length2 == 1;
+            }
+        } while (!done && (count1 | count2) < minGallop);
+
+        // Galloping, move whole blocks until neither run wins by much.
+        while (!done)
+        {
+            count1 = length1 - gallopRight(buffer[cursor2], a + base1,
+                                           length1, length1 - 1);
+            if (count1 != 0)
+            {
+                destination -= count1;
+                cursor1 -= count1;
+                length1 -= count1;
+                std::move_backward(a + (cursor1 + 1),
+                                   a + (cursor1 + 1 + count1),
+                                   a + (destination + 1 + count1));
+                if (length1 == 0)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            a[destination--] = std::move(buffer[cursor2--]);
+            if (--length2 == 1)
+            {
+                done = true;
+                break;
+            }
+
+            count2 = length2 - gallopLeft(a[cursor1], buffer, length2,
+                                          length2 - 1);
+            if (count2 != 0)
+            {
+                destination -= count2;
+                cursor2 -= count2;
+                length2 -= count2;
+                std::move(buffer + (cursor2 + 1),
+                          buffer + (cursor2 + 1 + count2),
+                          a + (destination + 1));
+                if (length2 <= 1)
+                {
+                    done = true;
+                    break;
+                }
+            }
+            a[destination--] = std::move(a[cursor1--]);
+            if (--length1 == 0)
+            {
+                done = true;
+                break;
+            }
+
+            --minGallop;
+            if (count1 < MIN_GALLOP && count2 < MIN_GALLOP)
+            {
+                break;
+            }
+        }
+        if (!done)
+        {
+            // Leaving galloping mode makes it harder to enter again.
+            minGallop = std::max(minGallop, Index{0}) + 2;
+        }
+    }
+    m_MinGallop = std::max(minGallop, Index{1});
+
+    if (length2 == 1)
+    {
+        destination -= length1;
+        cursor1 -= length1;
+        std::move_backward(a + (cursor1 + 1), a + (cursor1 + 1 + length1),
+                           a + (destination + 1 + length1));
+        a[destination] = std::move(buffer[cursor2]);
+    }
+    else if (length2 == 0)
+    {
+        throw std::invalid_argument(
+            "Compare function is not a strict weak ordering!");
+    }
+    else
+    {
+        std::move(buffer, buffer + length2,
+                  a + (destination - (length2 - 1)));
+    }
+}
+
+template <typename RandomIt, typename Compare>
+typename sort_impl::TimSort<RandomIt, Compare>::T* sort_impl::TimSort<
+    RandomIt, Compare>::bufferFor(Index length)
+{
+    if (m_Buffer.size() < static_cast<std::size_t>(length))
+    {
+        // Grow geometrically, but never beyond half of the range.
+        auto size{std::max(static_cast<std::size_t>(length),
+                           std::min(2 * m_Buffer.size(),
+                                    static_cast<std::size_t>(m_Size / 2)))};
+        sort_impl::countScratch(size * sizeof(T));
+        m_Buffer.resize(size);
+    }
+    return m_Buffer.data();
+}
+
+template <typename RandomIt, typename Compare>
+template <typename It>
+typename sort_impl::TimSort<RandomIt, Compare>::Index sort_impl::TimSort<
+    RandomIt, Compare>::gallopLeft(const T& key, It base, Index length,
+                                   Index hint)
+{
+    // Find the leftmost position to insert key into sorted [base, base +
+    // length): exponential search from hint, then binary search.
+    Index lastOffset{0};
+    Index offset{1};
+    if (m_Comp(base[hint], key))
+    {
+        Index maxOffset{length - hint};
+        while (offset < maxOffset && m_Comp(base[hint + offset], key))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+    else
+    {
+        Index maxOffset{hint + 1};
+        while (offset < maxOffset && !m_Comp(base[hint - offset], key))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        Index previous{lastOffset};
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    }
+
+    // Now base[lastOffset] < key <= base[offset].
+    ++lastOffset;
+    while (lastOffset < offset)
+    {
+        Index middle{lastOffset + (offset - lastOffset) / 2};
+        if (m_Comp(base[middle], key))
+        {
+            lastOffset = middle + 1;
+        }
+        else
+        {
+            offset = middle;
+        }
+    }
+    return offset;
+}
+
+template <typename RandomIt, typename Compare>
+template <typename It>
+typename sort_impl::TimSort<RandomIt, Compare>::Index sort_impl::TimSort<
+    RandomIt, Compare>::gallopRight(const T& key, It base, Index length,
+                                    Index hint)
+{
+    // Like gallopLeft, but finds the rightmost position to insert key.
+    Index lastOffset{0};
+    Index offset{1};
+    if (m_Comp(key, base[hint]))
+    {
+        Index maxOffset{hint + 1};
+        while (offset < maxOffset && m_Comp(key, base[hint - offset]))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        Index previous{lastOffset};
+        lastOffset = hint - offset;
+        offset = hint - previous;
+    }
+    else
+    {
+        Index maxOffset{length - hint};
+        while (offset < maxOffset && !m_Comp(key, base[hint + offset]))
+        {
+            lastOffset = offset;
+            offset = 2 * offset + 1;
+        }
+        offset = std::min(offset, maxOffset);
+        lastOffset += hint;
+        offset += hint;
+    }
+
+    // Now base[lastOffset] <= key < base[offset].
+    ++lastOffset;
+    while (lastOffset < offset)
+    {
+        Index middle{lastOffset + (offset - lastOffset) / 2};
+        if (m_Comp(key, base[middle]))
+        {
+            offset = middle;
+        }
+        else
+        {
+            lastOffset = middle + 1;
+        }
+    }
+    return offset;
+}
+
+// ------- Parallel Merge Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::parallelMergeSort(RandomIt first, RandomIt last, unsigned threads,
+                             Compare comp)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    if (last - first < 2)
+    {
+        return;
+    }
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    std::vector<T> buffer(static_cast<std::size_t>(last - first));
+    sort_impl::countScratch(buffer.size() * sizeof(T));
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::parallelMergeSort(first, last, buffer.begin(), threads, false,
+                                 counted);
+}
+
+template <typename RandomIt, typename BufferIt, typename Compare>
+void sort_impl::parallelMergeSort(RandomIt first, RandomIt last,
+                                  BufferIt buffer, unsigned threads,
+                                  bool toBuffer, Compare& comp)
+{
+    sort_impl::DepthGuard guard;
+    auto n{last - first};
+    if (threads < 2 || n < 2 * PARALLEL_GRAIN_SIZE)
+    {
+        sort_impl::mergeSort(first, last, buffer, comp);
+        if (toBuffer)
+        {
+            std::move(first, last, buffer);
+            sort_impl::countMoves(static_cast<std::uint64_t>(n));
+        }
+        return;
+    }
+
+    // Halves are sorted into the opposite storage of the one the merged
+    // result goes to, so merging never needs an extra copy.
+    auto half{n / 2};
+    unsigned leftThreads{threads / 2};
+    auto left{std::async(std::launch::async,
+                         [=, &comp, context{sort_impl::counterContext()}]() {
+                             sort_impl::CountersScope scope(context);
+                             sort_impl::parallelMergeSort(
+                                 first, first + half, buffer, leftThreads,
+                                 !toBuffer, comp);
+                         })};
+    sort_impl::parallelMergeSort(first + half, last, buffer + half,
+                                 threads - leftThreads, !toBuffer, comp);
+    left.get();
+
+    if (toBuffer)
+    {
+        sort_impl::parallelMerge(first, first + half, first + half, last,
+                                 buffer, threads, comp);
+    }
+    else
+    {
+        sort_impl::parallelMerge(buffer, buffer + half, buffer + half,
+                                 buffer + n, first, threads, comp);
+    }
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename Compare>
+OutputIt sort_impl::moveMerge(InputIt1 first1, InputIt1 last1,
+                              InputIt2 first2, InputIt2 last2, OutputIt out,
+                              Compare& comp)
+{
+    sort_impl::countMoves(
+        static_cast<std::uint64_t>((last1 - first1) + (last2 - first2)));
+    while (first1 != last1 && first2 != last2)
+    {
+        // Take from the first range on ties to keep the merge stable.
+        if (comp(*first2, *first1))
+        {
+            *out++ = std::move(*first2++);
+        }
+        else
+        {
+            *out++ = std::move(*first1++);
+        }
+    }
+    out = std::move(first1, last1, out);
+    return std::move(first2, last2, out);
+}
+
+template <typename InputIt1, typename InputIt2, typename OutputIt,
+          typename Compare>
+void sort_impl::parallelMerge(InputIt1 first1, InputIt1 last1,
+                              InputIt2 first2, InputIt2 last2, OutputIt out,
+                              unsigned threads, Compare& comp)
+{
+    sort_impl::DepthGuard guard;
+    auto n1{last1 - first1};
+    auto n2{last2 - first2};
+    if (threads < 2 || n1 + n2 < 2 * PARALLEL_GRAIN_SIZE)
+    {
+        sort_impl::moveMerge(first1, last1, first2, last2, out, comp);
+        return;
+    }
+
+    // Split the larger range in the middle and the other one by binary
+    // search, every element of the left parts goes before the right parts.
+    // Equal keys from the first range stay on the left to keep stability.
+    InputIt1 middle1;
+    InputIt2 middle2;
+    if (n1 >= n2)
+    {
+        middle1 = first1 + n1 / 2;
+        middle2 = std::lower_bound(first2, last2, *middle1, comp);
+    }
+    else
+    {
+        middle2 = first2 + n2 / 2;
+        middle1 = std::upper_bound(first1, last1, *middle2, comp);
+    }
+    OutputIt middleOut{out + (middle1 - first1) + (middle2 - first2)};
+
+    unsigned leftThreads{threads / 2};
+    auto left{std::async(std::launch::async,
+                         [=, &comp, context{sort_impl::counterContext()}]() {
+                             sort_impl::CountersScope scope(context);
+                             sort_impl::parallelMerge(first1, middle1, first2,
+                                                      middle2, out,
+                                                      leftThreads, comp);
+                         })};
+    sort_impl::parallelMerge(middle1, last1, middle2, last2, middleOut,
+                             threads - leftThreads, comp);
+    left.get();
+}
+
+// ------- Insertion Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::insertionSort(RandomIt first, RandomIt last, Compare comp)
+{
+    if (first == last)
+    {
+        return;
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    for (RandomIt i{first + 1}; i != last; ++i)
+    {
+        // Shift larger elements right and drop the value into the hole.
+        auto value{std::move(*i)};
+        RandomIt hole{i};
+        for (; hole != first && counted(value, *(hole - 1)); --hole)
+        {
+            *hole = std::move(*(hole - 1));
+        }
+        *hole = std::move(value);
+        sort_impl::countMoves(static_cast<std::uint64_t>(i - hole) + 2);
+    }
+}
+
+// ------- Quick Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::quickSort(RandomIt first, RandomIt last, Compare comp)
+{
+    auto n{last - first};
+    if (n < 2)
+    {
+        return;
+    }
+    // Introsort gives up on quick sort after 2 * log2(n) levels.
+    int depthLimit{0};
+    for (; n > 1; n /= 2)
+    {
+        depthLimit += 2;
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::introSort(first, last, depthLimit, counted);
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::introSort(RandomIt first, RandomIt last, int depthLimit,
+                          Compare& comp)
+{
+    sort_impl::DepthGuard guard;
+    while (last - first > INSERTION_SORT_THRESHOLD)
+    {
+        if (depthLimit == 0)
+        {
+            // Too many unbalanced partitions, heap sort keeps the worst case
+            // at O(n log n).
+            sort::heapSort(first, last, comp);
+            return;
+        }
+        --depthLimit;
+
+        sort_impl::selectPivot(first, last, comp);
+        auto [equalFirst, equalLast] = sort_impl::partition(first, last, comp);
+
+        // Recurse into the smaller part and loop over the larger one, so the
+        // stack depth stays within O(log n).
+        if (equalFirst - first < last - equalLast)
+        {
+            sort_impl::introSort(first, equalFirst, depthLimit, comp);
+            first = equalLast;
+        }
+        else
+        {
+            sort_impl::introSort(equalLast, last, depthLimit, comp);
+            last = equalFirst;
+        }
+    }
+    sort::insertionSort(first, last, comp);
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::sortThree(RandomIt a, RandomIt b, RandomIt c, Compare& comp)
+{
+    if (comp(*b, *a))
+    {
+        sort_impl::iterSwap(a, b);
+    }
+    if (comp(*c, *b))
+    {
+        sort_impl::iterSwap(b, c);
+        if (comp(*b, *a))
+        {
+            sort_impl::iterSwap(a, b);
+        }
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::selectPivot(RandomIt first, RandomIt last, Compare& comp)
+{
+    auto n{last - first};
+    RandomIt middle{first + n / 2};
+    if (n > NINTHER_THRESHOLD)
+    {
+        // Tukey's ninther, median of medians of three samples.
+        auto step{n / 8};
+        sort_impl::sortThree(first, first + step, first + 2 * step, comp);
+        sort_impl::sortThree(middle - step, middle, middle + step, comp);
+        sort_impl::sortThree(last - 1 - 2 * step, last - 1 - step, last - 1,
+                             comp);
+        sort_impl::sortThree(first + step, middle, last - 1 - step, comp);
+    }
+    else
+    {
+        sort_impl::sortThree(first, middle, last - 1, comp);
+    }
+    // Partition expects the pivot at the front.
+    sort_impl::iterSwap(first, middle);
+}
+
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, RandomIt> sort_impl::partition(RandomIt first,
+                                                   RandomIt last, Compare& comp)
+{
+    // Bentley-McIlroy three-way partitioning with the pivot at `first`. Keys
+    // equal to the pivot are parked at both ends of the range while scanning
+    // and swapped into the middle afterwards:
+    // [first, p) == pivot, [p, i) < pivot, (j, q] > pivot, (q, last) == pivot
+    auto isEqual = [&comp](const auto& a, const auto& b) {
+        return !comp(a, b) && !comp(b, a);
+    };
+    RandomIt pivot{first};
+    RandomIt i{first};
+    RandomIt j{last};
+    RandomIt p{first + 1};
+    RandomIt q{last};
+
+    while (true)
+    {
+        while (comp(*++i, *pivot))
+        {
+            if (i == last - 1)
+            {
+                break;
+            }
+        }
+        while (comp(*pivot, *--j))
+        {
+            if (j == first)
+            {
+                break;
+            }
+        }
+        if (i == j && isEqual(*i, *pivot))
+        {
+            sort_impl::iterSwap(p++, i);
+        }
+        if (i >= j)
+        {
+            break;
+        }
+        sort_impl::iterSwap(i, j);
+        if (isEqual(*i, *pivot))
+        {
+            sort_impl::iterSwap(p++, i);
+        }
+        if (isEqual(*j, *pivot))
+        {
+            sort_impl::iterSwap(--q, j);
+        }
+    }
+
+    // Move keys equal to the pivot from the ends to the middle.
+    RandomIt equalFirst{j + 1};
+    RandomIt equalLast{j + 1};
+    for (RandomIt k{first}; k != p; ++k)
+    {
+        sort_impl::iterSwap(k, --equalFirst);
+    }
+    for (RandomIt k{last}; k != q;)
+    {
+        sort_impl::iterSwap(--k, equalLast++);
+    }
+
+    return {equalFirst, equalLast};
+}
+
+// ------- Pattern-Defeating Quick Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::pdqSort(RandomIt first, RandomIt last, Compare comp)
+{
+    auto n{last - first};
+    if (n < 2)
+    {
+        return;
+    }
+    int badAllowed{0};
+    for (; n > 1; n /= 2)
+    {
+        ++badAllowed;
+    }
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::pdqSort(first, last, badAllowed, true, counted);
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::pdqSort(RandomIt first, RandomIt last, int badAllowed,
+                        bool leftmost, Compare& comp)
+{
+    sort_impl::DepthGuard guard;
+    while (true)
+    {
+        auto n{last - first};
+        if (n <= INSERTION_SORT_THRESHOLD)
+        {
+            // Ranges right of a pivot have it as sentinel before `first`.
+            if (leftmost)
+            {
+                sort::insertionSort(first, last, comp);
+            }
+            else
+            {
+                sort_impl::unguardedInsertionSort(first, last, comp);
+            }
+            return;
+        }
+
+        sort_impl::selectPivot(first, last, comp);
+
+        // The previous pivot is not greater than anything in this range. If
+        // it equals the new pivot, every key equal to it can be placed left
+        // in one pass and is already in its final position.
+        if (!leftmost && !comp(*(first - 1), *first))
+        {
+            first = sort_impl::partitionEqual(first, last, comp) + 1;
+            continue;
+        }
+
+        auto [pivot, alreadyPartitioned] =
+            sort_impl::blockPartition(first, last, comp);
+        auto leftSize{pivot - first};
+        auto rightSize{last - (pivot + 1)};
+
+        if (leftSize < n / 8 || rightSize < n / 8)
+        {
+            if (--badAllowed == 0)
+            {
+                sort::heapSort(first, last, comp);
+                return;
+            }
+            // Likely a pattern that fools the pivot selection, perturb both
+            // sides before they are partitioned again.
+            sort_impl::breakPatterns(first, pivot);
+            sort_impl::breakPatterns(pivot + 1, last);
+        }
+        else if (alreadyPartitioned &&
+                 sort_impl::partialInsertionSort(first, pivot, comp) &&
+                 sort_impl::partialInsertionSort(pivot + 1, last, comp))
+        {
+            // Nothing was out of place, the input was probably sorted.
+            return;
+        }
+
+        sort_impl::pdqSort(first, pivot, badAllowed, leftmost, comp);
+        first = pivot + 1;
+        leftmost = false;
+    }
+}
+
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, bool> sort_impl::blockPartition(RandomIt first,
+                                                    RandomIt last,
+                                                    Compare& comp)
+{
+    // Partitions around the pivot at `first` into [< pivot] pivot
+    // [>= pivot]. Returns the pivot position and whether no element had to
+    // be moved. Neither first scan checks bounds. Pivot selection leaves the
+    // largest of the samples the pivot is the median of behind it, at
+    // `last - 1` for median of three and at `last - 1 - n / 8` for the
+    // ninther, an element >= pivot that stops the scan to the right. The
+    // scan to the left is only unguarded once the scan to the right has
+    // passed an element < pivot, which stops it.
+    auto pivot{std::move(*first)};
+    RandomIt begin{first};
+    RandomIt end{last};
+
+    while (comp(*++begin, pivot))
+    {
+    }
+    if (begin - 1 == first)
+    {
+        while (begin < end && !comp(*--end, pivot))
+        {
+        }
+    }
+    else
+    {
+        // An element < pivot was passed, it stops the scan.
+        while (!comp(*--end, pivot))
+        {
+        }
+    }
+
+    bool alreadyPartitioned{begin >= end};
+    if (!alreadyPartitioned)
+    {
+        sort_impl::iterSwap(begin, end);
+        ++begin;
+
+        // Offsets of misplaced elements relative to the block base, left
+        // offsets count up from `leftBase`, right ones down from `rightBase`.
+        alignas(64) unsigned char leftOffsets[PARTITION_BLOCK];
+        alignas(64) unsigned char rightOffsets[PARTITION_BLOCK];
+        RandomIt leftBase{begin};
+        RandomIt rightBase{end};
+        std::size_t leftCount{0};
+        std::size_t rightCount{0};
+        std::size_t leftStart{0};
+        std::size_t rightStart{0};
+
+        while (begin < end)
+        {
+            // Refill empty offset buffers, splitting what is left between
+            // the sides that need it.
+            auto unknown{static_cast<std::size_t>(end - begin)};
+            std::size_t leftSplit{
+                leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown)
+                               : 0};
+            std::size_t rightSplit{rightCount == 0 ? unknown - leftSplit : 0};
+            leftSplit = std::min<std::size_t>(leftSplit, PARTITION_BLOCK);
+            rightSplit = std::min<std::size_t>(rightSplit, PARTITION_BLOCK);
+
+            // The offset is always stored, the count only advances for
+            // misplaced elements.
+            for (std::size_t i{0}; i < leftSplit; ++i)
+            {
+                leftOffsets[leftCount] = static_cast<unsigned char>(i);
+                leftCount += !comp(*begin, pivot);
+                ++begin;
+            }
+            for (std::size_t i{0}; i < rightSplit; ++i)
+            {
+                rightOffsets[rightCount] = static_cast<unsigned char>(i + 1);
+                rightCount += comp(*--end, pivot);
+            }
+
+            std::size_t count{std::min(leftCount, rightCount)};
+            sort_impl::swapOffsets(leftBase, rightBase,
+                                   leftOffsets + leftStart,
+                                   rightOffsets + rightStart, count,
+                                   leftCount == rightCount);
+            leftCount -= count;
+            rightCount -= count;
+            leftStart += count;
+            rightStart += count;
+            if (leftCount == 0)
+            {
+                leftStart = 0;
+                leftBase = begin;
+            }
+            if (rightCount == 0)
+            {
+                rightStart = 0;
+                rightBase = end;
+            }
+        }
+
+        // At most one side has misplaced elements left, move them next to
+        // the boundary.
+        while (leftCount > 0)
+        {
+            --leftCount;
+            sort_impl::iterSwap(leftBase + leftOffsets[leftStart + leftCount],
+                                --end);
+            begin = end;
+        }
+        while (rightCount > 0)
+        {
+            --rightCount;
+            sort_impl::iterSwap(
+                rightBase - rightOffsets[rightStart + rightCount], begin);
+            ++begin;
+        }
+    }
+
+    RandomIt pivotPosition{begin - 1};
+    *first = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+    sort_impl::countMoves(3);
+    return {pivotPosition, alreadyPartitioned};
+}
+
+template <typename RandomIt>
+void sort_impl::swapOffsets(RandomIt leftBase, RandomIt rightBase,
+                            const unsigned char* leftOffsets,
+                            const unsigned char* rightOffsets,
+                            std::size_t count, bool useSwaps)
+{
+    if (useSwaps)
+    {
+        // Both buffers get empty, plain swaps keep the element order that
+        // the next refill relies on.
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            sort_impl::iterSwap(leftBase + leftOffsets[i],
+                                rightBase - rightOffsets[i]);
+        }
+    }
+    else if (count > 0)
+    {
+        // A cyclic permutation needs one move per element instead of three.
+        RandomIt left{leftBase + leftOffsets[0]};
+        RandomIt right{rightBase - rightOffsets[0]};
+        auto tmp{std::move(*left)};
+        *left = std::move(*right);
+        for (std::size_t i{1}; i < count; ++i)
+        {
+            left = leftBase + leftOffsets[i];
+            *right = std::move(*left);
+            right = rightBase - rightOffsets[i];
+            *left = std::move(*right);
+        }
+        *right = std::move(tmp);
+        sort_impl::countMoves(2 * count + 1);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+RandomIt sort_impl::partitionEqual(RandomIt first, RandomIt last,
+                                   Compare& comp)
+{
+    // Partitions around the pivot at `first` into [<= pivot] [> pivot] and
+    // returns the position of the last element <= pivot. The previous pivot
+    // before `first` stops the scan from the right.
+    auto pivot{std::move(*first)};
+    RandomIt begin{first};
+    RandomIt end{last};
+
+    while (comp(pivot, *--end))
+    {
+    }
+    if (end + 1 == last)
+    {
+        while (begin < end && !comp(pivot, *++begin))
+        {
+        }
+    }
+    else
+    {
+        while (!comp(pivot, *++begin))
+        {
+        }
+    }
+
+    while (begin < end)
+    {
+        sort_impl::iterSwap(begin, end);
+        while (comp(pivot, *--end))
+        {
+        }
+        while (!comp(pivot, *++begin))
+        {
+        }
+    }
+
+    *first = std::move(*end);
+    *end = std::move(pivot);
+    sort_impl::countMoves(3);
+    return end;
+}
+
+template <typename RandomIt, typename Compare>
+void sort_impl::unguardedInsertionSort(RandomIt first, RandomIt last,
+                                       Compare& comp)
+{
+    // Like `sort::insertionSort`, but the element before `first` is not
+    // greater than any element of the range and ends the inner loop.
+    for (RandomIt i{first}; i != last; ++i)
+    {
+        auto value{std::move(*i)};
+        RandomIt hole{i};
+        for (; comp(value, *(hole - 1)); --hole)
+        {
+            *hole = std::move(*(hole - 1));
+        }
+        *hole = std::move(value);
+        sort_impl::countMoves(static_cast<std::uint64_t>(i - hole) + 2);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+bool sort_impl::partialInsertionSort(RandomIt first, RandomIt last,
+                                     Compare& comp)
+{
+    // Insertion sort that gives up once too many elements had to be moved.
+    // Returns whether the range was sorted.
+    if (first == last)
+    {
+        return true;
+    }
+    std::ptrdiff_t moves{0};
+    for (RandomIt i{first + 1}; i != last; ++i)
+    {
+        if (!comp(*i, *(i - 1)))
+        {
+            continue;
+        }
+        auto value{std::move(*i)};
+        RandomIt hole{i};
+        for (; hole != first && comp(value, *(hole - 1)); --hole)
+        {
+            *hole = std::move(*(hole - 1));
+        }
+        *hole = std::move(value);
+        moves += i - hole;
+        sort_impl::countMoves(static_cast<std::uint64_t>(i - hole) + 2);
+        if (moves > PARTIAL_INSERTION_SORT_LIMIT)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename RandomIt>
+void sort_impl::breakPatterns(RandomIt first, RandomIt last)
+{
+    // Swap elements at both ends with ones a quarter inside, which moves the
+    // samples of the next pivot selection to different places.
+    auto n{last - first};
+    if (n < INSERTION_SORT_THRESHOLD)
+    {
+        return;
+    }
+    auto quarter{n / 4};
+    sort_impl::iterSwap(first, first + quarter);
+    sort_impl::iterSwap(last - 1, last - quarter);
+    if (n > NINTHER_THRESHOLD)
+    {
+        sort_impl::iterSwap(first + 1, first + (quarter + 1));
+        sort_impl::iterSwap(first + 2, first + (quarter + 2));
+        sort_impl::iterSwap(last - 2, last - (quarter + 1));
+        sort_impl::iterSwap(last - 3, last - (quarter + 2));
+    }
+}
+
+// ------- Heap Sort -----------------------------
+
+template <typename RandomIt, typename Compare>
+void sort::heapSort(RandomIt first, RandomIt last, Compare comp)
+{
+    sort::heapSort<2>(first, last, comp);
+}
+
+template <int Arity, typename RandomIt, typename Compare>
+void sort::heapSort(RandomIt first, RandomIt last, Compare comp)
+{
+    static_assert(Arity >= 2, "Heap nodes need at least two children!");
+
+    auto n{last - first};
+    auto&& counted{sort_impl::countingCompare(comp)};
+    sort_impl::makeHeap<Arity>(first, n, counted);
+    sort_impl::sortHeap<Arity>(first, n, counted);
+}
+
+template <int Arity, typename RandomIt, typename Compare>
+void sort_impl::makeHeap(
+    RandomIt first, typename std::iterator_traits<RandomIt>::difference_type n,
+    Compare& comp)
+{
+    // Max heap with respect to `comp`, the element that goes last is the
+    // root. Children of node i are Arity * i + 1 ... Arity * i + Arity.
+    if (n < 2)
+    {
+        return;
+    }
+    for (auto i{(n - 2) / Arity}; i >= 0; --i)
+    {
+        // Heapify subtrees starting from the parent of the last element.
+        sort_impl::heapify<Arity>(first, n, i, comp);
+    }
+}
+
+template <int Arity, typename RandomIt, typename Compare>
+void sort_impl::sortHeap(
+    RandomIt first, typename std::iterator_traits<RandomIt>::difference_type n,
+    Compare& comp)
+{
+    using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+
+    for (Difference end{n - 1}; end > 0; --end)
+    {
+        // Floyd's pop: the root moves to the end, its hole sinks to a leaf
+        // along the larger children without comparing against the element
+        // being placed, which is sifted up from the leaf afterwards.
+        auto value{std::move(first[end])};
+        first[end] = std::move(first[0]);
+        Difference hole{0};
+        std::uint64_t moves{0};
+        for (Difference child{1}; child < end; child = Arity * hole + 1)
+        {
+            Difference largest{
+                sort_impl::largestChild<Arity>(first, end, child, comp)};
+            first[hole] = std::move(first[largest]);
+            hole = largest;
+            ++moves;
+        }
+        while (hole > 0)
+        {
+            Difference parent{(hole - 1) / Arity};
+            if (!comp(first[parent], value))
+            {
+                break;
+            }
+            first[hole] = std::move(first[parent]);
+            hole = parent;
+            ++moves;
+        }
+        first[hole] = std::move(value);
+        sort_impl::countMoves(moves + 3);
+    }
+}
+
+template <int Arity, typename RandomIt, typename Compare>
+typename std::iterator_traits<RandomIt>::difference_type sort_impl::
+    largestChild(RandomIt first,
+                 typename std::iterator_traits<RandomIt>::difference_type n,
+                 typename std::iterator_traits<RandomIt>::difference_type child,
+                 Compare& comp)
+{
+    // Index of the largest of the siblings starting at `child`.
+    auto largest{child};
+    if (child + Arity <= n)
+    {
+        // Full node, the loop has a constant trip count.
+        for (int k{1}; k < Arity; ++k)
+        {
+            if (comp(first[largest], first[child + k]))
+            {
+                largest = child + k;
+            }
+        }
+        return largest;
+    }
+    for (auto k{child + 1}; k < n; ++k)
+    {
+        if (comp(first[largest], first[k]))
+        {
+            largest = k;
+        }
+    }
+    return largest;
+}
+
+template <int Arity, typename RandomIt, typename Compare>
+void sort_impl::heapify(
+    RandomIt first, typename std::iterator_traits<RandomIt>::difference_type n,
+    typename std::iterator_traits<RandomIt>::difference_type index,
+    Compare& comp)
+{
+    // Top-down sift of the element at index, moving a hole instead of
+    // swapping at every level.
+    auto value{std::move(first[index])};
+    std::uint64_t moves{2};
+    for (auto child{Arity * index + 1}; child < n; child = Arity * index + 1)
+    {
+        auto largest{sort_impl::largestChild<Arity>(first, n, child, comp)};
+        if (!comp(value, first[largest]))
+        {
+            break;
+        }
+        first[index] = std::move(first[largest]);
+        index = largest;
+        ++moves;
+    }
+    first[index] = std::move(value);
+    sort_impl::countMoves(moves);
+}
+
+// ------- Radix Sort -----------------------------
+
+template <typename RandomIt>
+void sort::radixSort(RandomIt first, RandomIt last)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    sort_impl::radixSort(first, last, [](const T& value) {
+        return sort_impl::RadixKey<T>::encode(value);
+    });
+}
+
+template <typename RandomIt, typename KeyOf>
+void sort_impl::radixSort(RandomIt first, RandomIt last, KeyOf keyOf)
+{
+    // Sorts by the unsigned key `keyOf` extracts from each element.
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::invoke_result_t<KeyOf&, const T&>;
+    constexpr int passes{static_cast<int>(sizeof(Key))};
+
+    auto n{static_cast<std::size_t>(last - first)};
+    if (n < 2)
+    {
+        return;
+    }
+
+    // Histograms for every digit are built together, so the input is read
+    // only once before the scatter passes start.
+    std::vector<std::array<std::size_t, RADIX_BUCKETS>> histograms(passes);
+    for (RandomIt it{first}; it != last; ++it)
+    {
+        Key key{keyOf(*it)};
+        for (int pass{0}; pass < passes; ++pass)
+        {
+            ++histograms[pass][(key >> (pass * RADIX_BITS)) &
+                               (RADIX_BUCKETS - 1)];
+        }
+    }
+
+    std::vector<T> buffer(n);
+    sort_impl::countScratch(passes * sizeof(histograms[0]) + n * sizeof(T));
+    bool inBuffer{false};
+    Key firstKey{keyOf(*first)};
+    for (int pass{0}; pass < passes; ++pass)
+    {
+        int shift{pass * RADIX_BITS};
+        auto& counts{histograms[pass]};
+        if (counts[(firstKey >> shift) & (RADIX_BUCKETS - 1)] == n)
+        {
+            // All keys share this digit, the pass would not change anything.
+            continue;
+        }
+
+        // Turn counts into bucket start offsets.
+        std::size_t offset{0};
+        for (std::size_t& count : counts)
+        {
+            std::size_t bucketSize{count};
+            count = offset;
+            offset += bucketSize;
+        }
+
+        if (inBuffer)
+        {
+            sort_impl::radixScatter(buffer.begin(), n, first, counts.data(),
+                                    shift, keyOf);
+        }
+        else
+        {
+            sort_impl::radixScatter(first, n, buffer.begin(), counts.data(),
+                                    shift, keyOf);
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer)
+    {
+        std::move(buffer.begin(), buffer.end(), first);
+        sort_impl::countMoves(n);
+    }
+}
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf>
+void sort_impl::radixScatter(SourceIt source, std::size_t n,
+                             DestinationIt destination, std::size_t* offsets,
+                             int shift, KeyOf& keyOf)
+{
+    sort_impl::countMoves(n);
+    for (std::size_t i{0}; i < n; ++i, ++source)
+    {
+        auto digit{(keyOf(*source) >> shift) & (RADIX_BUCKETS - 1)};
+        destination[offsets[digit]++] = std::move(*source);
+    }
+}
+
+// ------- Parallel Radix Sort -----------------------------
+
+template <typename RandomIt>
+void sort::parallelRadixSort(RandomIt first, RandomIt last, unsigned threads)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    if (threads == 0)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    sort_impl::parallelRadixSort(first, last, threads, [](const T& value) {
+        return sort_impl::RadixKey<T>::encode(value);
+    });
+}
+
+template <typename RandomIt, typename KeyOf>
+void sort_impl::parallelRadixSort(RandomIt first, RandomIt last,
+                                  unsigned threads, KeyOf keyOf)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::invoke_result_t<KeyOf&, const T&>;
+    using Histogram = std::array<std::size_t, RADIX_BUCKETS>;
+    constexpr int passes{static_cast<int>(sizeof(Key))};
+
+    auto n{static_cast<std::size_t>(last - first)};
+    auto maxThreads{n / static_cast<std::size_t>(PARALLEL_GRAIN_SIZE)};
+    if (threads < 2 || maxThreads < 2)
+    {
+        sort_impl::radixSort(first, last, keyOf);
+        return;
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, maxThreads));
+
+    // Thread t works on the elements [chunk(t), chunk(t + 1)) of every pass.
+    auto chunk{[n, threads](unsigned t) { return n / threads * t; }};
+    auto chunkEnd{[n, threads, &chunk](unsigned t) {
+        return t + 1 == threads ? n : chunk(t + 1);
+    }};
+    auto forEachThread{[threads](auto task) {
+        std::vector<std::future<void>> tasks;
+        for (unsigned t{1}; t < threads; ++t)
+        {
+            tasks.push_back(std::async(
+                std::launch::async,
+                [task, t, context{sort_impl::counterContext()}]() {
+                    sort_impl::CountersScope scope(context);
+                    task(t);
+                }));
+        }
+        task(0U);
+        for (std::future<void>& t : tasks)
+        {
+            t.get();
+        }
+    }};
+
+    // Histograms of every digit for the input chunks, the totals tell which
+    // passes can be skipped, the chunk counts serve the first pass.
+    std::vector<std::vector<Histogram>> histograms(
+        threads, std::vector<Histogram>(passes));
+    forEachThread([&](unsigned t) {
+        for (std::size_t i{chunk(t)}; i < chunkEnd(t); ++i)
+        {
+            Key key{keyOf(first[i])};
+            for (int pass{0}; pass < passes; ++pass)
+            {
+                ++histograms[t][pass][(key >> (pass * RADIX_BITS)) &
+                                      (RADIX_BUCKETS - 1)];
+            }
+        }
+    });
+
+    std::vector<T> buffer(n);
+    sort_impl::countScratch(threads * passes * sizeof(Histogram) +
+                            n * sizeof(T));
+    bool inBuffer{false};
+    bool firstScatter{true};
+    Key firstKey{keyOf(*first)};
+    auto runPass{[&](auto source, auto destination, int pass) {
+        int shift{pass * RADIX_BITS};
+        if (!firstScatter)
+        {
+            // Chunks hold other elements after a scatter, count them again.
+            forEachThread([&](unsigned t) {
+                Histogram& counts{histograms[t][pass]};
+                counts.fill(0);
+                for (std::size_t i{chunk(t)}; i < chunkEnd(t); ++i)
+                {
+                    ++counts[(keyOf(source[i]) >> shift) &
+                             (RADIX_BUCKETS - 1)];
+                }
+            });
+        }
+        firstScatter = false;
+
+        // Bucket by bucket, thread by thread within a bucket, so elements
+        // keep their order and the sort stays stable.
+        std::size_t offset{0};
+        for (std::size_t bucket{0}; bucket < RADIX_BUCKETS; ++bucket)
+        {
+            for (unsigned t{0}; t < threads; ++t)
+            {
+                std::size_t bucketSize{histograms[t][pass][bucket]};
+                histograms[t][pass][bucket] = offset;
+                offset += bucketSize;
+            }
+        }
+
+        forEachThread([&](unsigned t) {
+            sort_impl::radixScatterBuffered(
+                source + chunk(t), chunkEnd(t) - chunk(t), destination,
+                histograms[t][pass].data(), shift, keyOf);
+        });
+    }};
+
+    for (int pass{0}; pass < passes; ++pass)
+    {
+        std::size_t total{0};
+        std::size_t digit{(firstKey >> (pass * RADIX_BITS)) &
+                          (RADIX_BUCKETS - 1)};
+        for (unsigned t{0}; t < threads; ++t)
+        {
+            total += histograms[t][pass][digit];
+        }
+        if (total == n)
+        {
+            // All keys share this digit, the pass would not change anything.
+            continue;
+        }
+
+        if (inBuffer)
+        {
+            runPass(buffer.begin(), first, pass);
+        }
+        else
+        {
+            runPass(first, buffer.begin(), pass);
+        }
+        inBuffer = !inBuffer;
+    }
+
+    if (inBuffer)
+    {
+        forEachThread([&](unsigned t) {
+            std::move(buffer.begin() + chunk(t), buffer.begin() + chunkEnd(t),
+                      first + chunk(t));
+        });
+        sort_impl::countMoves(n);
+    }
+}
+
+template <typename SourceIt, typename DestinationIt, typename KeyOf>
+void sort_impl::radixScatterBuffered(SourceIt source, std::size_t n,
+                                     DestinationIt destination,
+                                     std::size_t* offsets, int shift,
+                                     KeyOf& keyOf)
+{
+    using T = typename std::iterator_traits<SourceIt>::value_type;
+    constexpr std::size_t slots{
+        std::max<std::size_t>(RADIX_WRITE_BUFFER / sizeof(T), 1)};
+
+    // Elements of a bucket wait in its line until the line is full.
+    std::vector<T> lines(RADIX_BUCKETS * slots);
+    sort_impl::countScratch(lines.size() * sizeof(T));
+    sort_impl::countMoves(2 * n);
+    std::array<std::size_t, RADIX_BUCKETS> used{};
+    for (std::size_t i{0}; i < n; ++i, ++source)
+    {
+        auto digit{(keyOf(*source) >> shift) & (RADIX_BUCKETS - 1)};
+        T* line{lines.data() + digit * slots};
+        line[used[digit]++] = std::move(*source);
+        if (used[digit] == slots)
+        {
+            std::move(line, line + slots, destination + offsets[digit]);
+            offsets[digit] += slots;
+            used[digit] = 0;
+        }
+    }
+    for (std::size_t digit{0}; digit < RADIX_BUCKETS; ++digit)
+    {
+        T* line{lines.data() + digit * slots};
+        std::move(line, line + used[digit], destination + offsets[digit]);
+        offsets[digit] += used[digit];
+    }
+}
@@ -0,0 +1,653 @@
+#include "Algorithms/SortingNetworks.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "Algorithms/Sorting.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define SORTING_NETWORKS_X86
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE4 __attribute__((target("sse4.1")))
+#endif
+
+// ------- CPU feature detection -----------------------------
+
+static sort::SimdLevel detectSimdLevel()
+{
+#ifdef SORTING_NETWORKS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return sort::SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return sort::SimdLevel::SSE4;
+    }
+#endif
+    return sort::SimdLevel::Scalar;
+}
+
+static sort::SimdLevel detectedSimdLevel()
+{
+    static const sort::SimdLevel level{detectSimdLevel()};
+    return level;
+}
+
+static std::atomic<sort::SimdLevel>& currentSimdLevel()
+{
+    static std::atomic<sort::SimdLevel> level{detectedSimdLevel()};
+    return level;
+}
+
+sort::SimdLevel sort::simdLevel()
+{
+    return currentSimdLevel().load(std::memory_order_relaxed);
+}
+
+sort::SimdLevel sort::setSimdLevel(SimdLevel level)
+{
+    level = std::min(level, detectedSimdLevel());
+    currentSimdLevel().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+template <typename T>
+static T sentinel()
+{
+    // Padding value that goes after every real element.
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return std::numeric_limits<T>::infinity();
+    }
+    else
+    {
+        return std::numeric_limits<T>::max();
+    }
+}
+
+#ifdef SORTING_NETWORKS_X86
+
+// ------- AVX2 kernels -----------------------------
+
+struct Avx2Int
+{
+    using T = int;
+    using Vector = __m256i;
+    static constexpr int LANES{8};
+
+    TARGET_AVX2 static Vector load(const T* p)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    TARGET_AVX2 static void store(T* p, Vector v)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    TARGET_AVX2 static Vector min(Vector a, Vector b)
+    {
+        return _mm256_min_epi32(a, b);
+    }
+    TARGET_AVX2 static Vector max(Vector a, Vector b)
+    {
+        return _mm256_max_epi32(a, b);
+    }
+    TARGET_AVX2 static Vector permute(Vector v, __m256i index)
+    {
+        return _mm256_permutevar8x32_epi32(v, index);
+    }
+    TARGET_AVX2 static Vector blend(Vector a, Vector b, __m256i mask)
+    {
+        return _mm256_blendv_epi8(a, b, mask);
+    }
+};
+
+struct Avx2Float
+{
+    using T = float;
+    using Vector = __m256;
+    static constexpr int LANES{8};
+
+    TARGET_AVX2 static Vector load(const T* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+    TARGET_AVX2 static void store(T* p, Vector v)
+    {
+        _mm256_storeu_ps(p, v);
+    }
+    TARGET_AVX2 static Vector min(Vector a, Vector b)
+    {
+        return _mm256_min_ps(a, b);
+    }
+    TARGET_AVX2 static Vector max(Vector a, Vector b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+    TARGET_AVX2 static Vector permute(Vector v, __m256i index)
+    {
+        return _mm256_permutevar8x32_ps(v, index);
+    }
+    TARGET_AVX2 static Vector blend(Vector a, Vector b, __m256i mask)
+    {
+        return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask));
+    }
+};
+
+TARGET_AVX2 static __m256i avx2Partners(int j)
+{
+    // Lane i is compared with lane i ^ j.
+    return _mm256_xor_si256(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                            _mm256_set1_epi32(j));
+}
+
+TARGET_AVX2 static __m256i avx2MaxLanes(int base, int j, int k)
+{
+    // Lane takes the larger value if it is the upper one of the compared pair
+    // in an ascending block, or the lower one in a descending block.
+    __m256i lanes{_mm256_add_epi32(_mm256_set1_epi32(base),
+                                   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))};
+    __m256i upper{_mm256_cmpeq_epi32(
+        _mm256_and_si256(lanes, _mm256_set1_epi32(j)), _mm256_set1_epi32(j))};
+    __m256i descending{_mm256_cmpeq_epi32(
+        _mm256_and_si256(lanes, _mm256_set1_epi32(k)), _mm256_set1_epi32(k))};
+    return _mm256_xor_si256(upper, descending);
+}
+
+template <typename Ops>
+TARGET_AVX2 static void bitonicSortAvx2(typename Ops::T* block, int size)
+{
+    using Vector = typename Ops::Vector;
+
+    for (int k{2}; k <= size; k *= 2)
+    {
+        for (int j{k / 2}; j > 0; j /= 2)
+        {
+            if (j >= Ops::LANES)
+            {
+                // Compare-exchange between whole vectors.
+                for (int i{0}; i < size; i += Ops::LANES)
+                {
+                    if ((i & j) != 0)
+                    {
+                        continue;
+                    }
+                    Vector a{Ops::load(block + i)};
+                    Vector b{Ops::load(block + i + j)};
+                    bool ascending{(i & k) == 0};
+                    Ops::store(block + i,
+                               ascending ? Ops::min(a, b) : Ops::max(a, b));
+                    Ops::store(block + i + j,
+                               ascending ? Ops::max(a, b) : Ops::min(a, b));
+                }
+            }
+            else
+            {
+                // Compare-exchange between lanes of the same vector.
+                __m256i partners{avx2Partners(j)};
+                for (int i{0}; i < size; i += Ops::LANES)
+                {
+                    Vector v{Ops::load(block + i)};
+                    Vector p{Ops::permute(v, partners)};
+                    Ops::store(block + i,
+                               Ops::blend(Ops::min(v, p), Ops::max(v, p),
+                                          avx2MaxLanes(i, j, k)));
+                }
+            }
+        }
+    }
+}
+
+template <typename Ops>
+TARGET_AVX2 static void mergeVectorsAvx2(typename Ops::Vector& low,
+                                         typename Ops::Vector& high)
+{
+    using Vector = typename Ops::Vector;
+
+    // Sorted low followed by reversed high is a bitonic sequence, one
+    // compare-exchange splits it into halves, each cleaned up in register.
+    Vector reversed{
+        Ops::permute(high, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0))};
+    Vector a{Ops::min(low, reversed)};
+    Vector b{Ops::max(low, reversed)};
+    for (int j{Ops::LANES / 2}; j > 0; j /= 2)
+    {
+        __m256i partners{avx2Partners(j)};
+        __m256i maxLanes{avx2MaxLanes(0, j, 2 * Ops::LANES)};
+        Vector pa{Ops::permute(a, partners)};
+        Vector pb{Ops::permute(b, partners)};
+        a = Ops::blend(Ops::min(a, pa), Ops::max(a, pa), maxLanes);
+        b = Ops::blend(Ops::min(b, pb), Ops::max(b, pb), maxLanes);
+    }
+    low = a;
+    high = b;
+}
+
+template <typename Ops>
+TARGET_AVX2 static typename Ops::Vector loadBlockAvx2(
+    const typename Ops::T* source, std::size_t index, std::size_t n)
+{
+    using T = typename Ops::T;
+
+    if (index + Ops::LANES <= n)
+    {
+        return Ops::load(source + index);
+    }
+    T padded[Ops::LANES];
+    std::fill(std::copy(source + index, source + n, padded),
+              padded + Ops::LANES, sentinel<T>());
+    return Ops::load(padded);
+}
+
+template <typename Ops>
+TARGET_AVX2 static void storeBlockAvx2(typename Ops::T* out, std::size_t index,
+                                       std::size_t n,
+                                       typename Ops::Vector v)
+{
+    using T = typename Ops::T;
+
+    if (index + Ops::LANES <= n)
+    {
+        Ops::store(out + index, v);
+        return;
+    }
+    T padded[Ops::LANES];
+    Ops::store(padded, v);
+    std::copy(padded, padded + (n - index), out + index);
+}
+
+template <typename Ops>
+TARGET_AVX2 static void bitonicMergeAvx2(const typename Ops::T* left,
+                                         std::size_t nLeft,
+                                         const typename Ops::T* right,
+                                         std::size_t nRight,
+                                         typename Ops::T* out)
+{
+    using Vector = typename Ops::Vector;
+
+    std::size_t n{nLeft + nRight};
+    Vector low{loadBlockAvx2<Ops>(left, 0, nLeft)};
+    Vector high{loadBlockAvx2<Ops>(right, 0, nRight)};
+    std::size_t leftIndex{Ops::LANES};
+    std::size_t rightIndex{Ops::LANES};
+    for (std::size_t written{0}; written < n; written += Ops::LANES)
+    {
+        mergeVectorsAvx2<Ops>(low, high);
+        storeBlockAvx2<Ops>(out, written, n, low);
+
+        // Next block comes from the input with the smaller head, so the
+        // elements kept in high are never larger than the ones written later.
+        if (leftIndex < nLeft &&
+            (rightIndex >= nRight || !(right[rightIndex] < left[leftIndex])))
+        {
+            low = loadBlockAvx2<Ops>(left, leftIndex, nLeft);
+            leftIndex += Ops::LANES;
+        }
+        else if (rightIndex < nRight)
+        {
+            low = loadBlockAvx2<Ops>(right, rightIndex, nRight);
+            rightIndex += Ops::LANES;
+        }
+        else
+        {
+            if (written + Ops::LANES < n)
+            {
+                storeBlockAvx2<Ops>(out, written + Ops::LANES, n, high);
+            }
+            return;
+        }
+    }
+}
+
+// ------- SSE4.1 kernels -----------------------------
+// Same algorithms as the AVX2 kernels on 4 lanes, lane permutations use
+// immediate shuffles.
+
+struct Sse4Int
+{
+    using T = int;
+    using Vector = __m128i;
+    static constexpr int LANES{4};
+
+    TARGET_SSE4 static Vector load(const T* p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    TARGET_SSE4 static void store(T* p, Vector v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+    TARGET_SSE4 static Vector min(Vector a, Vector b)
+    {
+        return _mm_min_epi32(a, b);
+    }
+    TARGET_SSE4 static Vector max(Vector a, Vector b)
+    {
+        return _mm_max_epi32(a, b);
+    }
+    TARGET_SSE4 static Vector swapLanes(Vector v, int j)
+    {
+        return j == 1 ? _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1))
+                      : _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    TARGET_SSE4 static Vector reverse(Vector v)
+    {
+        return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    TARGET_SSE4 static Vector blend(Vector a, Vector b, __m128i mask)
+    {
+        return _mm_blendv_epi8(a, b, mask);
+    }
+};
+
+struct Sse4Float
+{
+    using T = float;
+    using Vector = __m128;
+    static constexpr int LANES{4};
+
+    TARGET_SSE4 static Vector load(const T* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+    TARGET_SSE4 static void store(T* p, Vector v)
+    {
+        _mm_storeu_ps(p, v);
+    }
+    TARGET_SSE4 static Vector min(Vector a, Vector b)
+    {
+        return _mm_min_ps(a, b);
+    }
+    TARGET_SSE4 static Vector max(Vector a, Vector b)
+    {
+        return _mm_max_ps(a, b);
+    }
+    TARGET_SSE4 static Vector swapLanes(Vector v, int j)
+    {
+        return j == 1 ? _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))
+                      : _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+    TARGET_SSE4 static Vector reverse(Vector v)
+    {
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+    }
+    TARGET_SSE4 static Vector blend(Vector a, Vector b, __m128i mask)
+    {
+        return _mm_blendv_ps(a, b, _mm_castsi128_ps(mask));
+    }
+};
+
+TARGET_SSE4 static __m128i sse4MaxLanes(int base, int j, int k)
+{
+    __m128i lanes{
+        _mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3))};
+    __m128i upper{_mm_cmpeq_epi32(_mm_and_si128(lanes, _mm_set1_epi32(j)),
+                                  _mm_set1_epi32(j))};
+    __m128i descending{_mm_cmpeq_epi32(
+        _mm_and_si128(lanes, _mm_set1_epi32(k)), _mm_set1_epi32(k))};
+    return _mm_xor_si128(upper, descending);
+}
+
+template <typename Ops>
+TARGET_SSE4 static void bitonicSortSse4(typename Ops::T* block, int size)
+{
+    using Vector = typename Ops::Vector;
+
+    for (int k{2}; k <= size; k *= 2)
+    {
+        for (int j{k / 2}; j > 0; j /= 2)
+        {
+            if (j >= Ops::LANES)
+            {
+                for (int i{0}; i < size; i += Ops::LANES)
+                {
+                    if ((i & j) != 0)
+                    {
+                        continue;
+                    }
+                    Vector a{Ops::load(block + i)};
+                    Vector b{Ops::load(block + i + j)};
+                    bool ascending{(i & k) == 0};
+                    Ops::store(block + i,
+                               ascending ? Ops::min(a, b) : Ops::max(a, b));
+                    Ops::store(block + i + j,
+                               ascending ? Ops::max(a, b) : Ops::min(a, b));
+                }
+            }
+            else
+            {
+                for (int i{0}; i < size; i += Ops::LANES)
+                {
+                    Vector v{Ops::load(block + i)};
+                    Vector p{Ops::swapLanes(v, j)};
+                    Ops::store(block + i,
+                               Ops::blend(Ops::min(v, p), Ops::max(v, p),
+                                          sse4MaxLanes(i, j, k)));
+                }
+            }
+        }
+    }
+}
+
+template <typename Ops>
+TARGET_SSE4 static void mergeVectorsSse4(typename Ops::Vector& low,
+                                         typename Ops::Vector& high)
+{
+    using Vector = typename Ops::Vector;
+
+    Vector reversed{Ops::reverse(high)};
+    Vector a{Ops::min(low, reversed)};
+    Vector b{Ops::max(low, reversed)};
+    for (int j{Ops::LANES / 2}; j > 0; j /= 2)
+    {
+        __m128i maxLanes{sse4MaxLanes(0, j, 2 * Ops::LANES)};
+        Vector pa{Ops::swapLanes(a, j)};
+        Vector pb{Ops::swapLanes(b, j)};
+        a = Ops::blend(Ops::min(a, pa), Ops::max(a, pa), maxLanes);
+        b = Ops::blend(Ops::min(b, pb), Ops::max(b, pb), maxLanes);
+    }
+    low = a;
+    high = b;
+}
+
+template <typename Ops>
+TARGET_SSE4 static typename Ops::Vector loadBlockSse4(
+    const typename Ops::T* source, std::size_t index, std::size_t n)
+{
+    using T = typename Ops::T;
+
+    if (index + Ops::LANES <= n)
+    {
+        return Ops::load(source + index);
+    }
+    T padded[Ops::LANES];
+    std::fill(std::copy(source + index, source + n, padded),
+              padded + Ops::LANES, sentinel<T>());
+    return Ops::load(padded);
+}
+
+template <typename Ops>
+TARGET_SSE4 static void storeBlockSse4(typename Ops::T* out, std::size_t index,
+                                       std::size_t n,
+                                       typename Ops::Vector v)
+{
+    using T = typename Ops::T;
+
+    if (index + Ops::LANES <= n)
+    {
+        Ops::store(out + index, v);
+        return;
+    }
+    T padded[Ops::LANES];
+    Ops::store(padded, v);
+    std::copy(padded, padded + (n - index), out + index);
+}
+
+template <typename Ops>
+TARGET_SSE4 static void bitonicMergeSse4(const typename Ops::T* left,
+                                         std::size_t nLeft,
+                                         const typename Ops::T* right,
+                                         std::size_t nRight,
+                                         typename Ops::T* out)
+{
+    using Vector = typename Ops::Vector;
+
+    std::size_t n{nLeft + nRight};
+    Vector low{loadBlockSse4<Ops>(left, 0, nLeft)};
+    Vector high{loadBlockSse4<Ops>(right, 0, nRight)};
+    std::size_t leftIndex{Ops::LANES};
+    std::size_t rightIndex{Ops::LANES};
+    for (std::size_t written{0}; written < n; written += Ops::LANES)
+    {
+        mergeVectorsSse4<Ops>(low, high);
+        storeBlockSse4<Ops>(out, written, n, low);
+
+        if (leftIndex < nLeft &&
+            (rightIndex >= nRight || !(right[rightIndex] < left[leftIndex])))
+        {
+            low = loadBlockSse4<Ops>(left, leftIndex, nLeft);
+            leftIndex += Ops::LANES;
+        }
+        else if (rightIndex < nRight)
+        {
+            low = loadBlockSse4<Ops>(right, rightIndex, nRight);
+            rightIndex += Ops::LANES;
+        }
+        else
+        {
+            if (written + Ops::LANES < n)
+            {
+                storeBlockSse4<Ops>(out, written + Ops::LANES, n, high);
+            }
+            return;
+        }
+    }
+}
+
+template <typename T>
+struct SimdOps;
+
+template <>
+struct SimdOps<int>
+{
+    using Avx2 = Avx2Int;
+    using Sse4 = Sse4Int;
+};
+
+template <>
+struct SimdOps<float>
+{
+    using Avx2 = Avx2Float;
+    using Sse4 = Sse4Float;
+};
+
+#endif // SORTING_NETWORKS_X86
+
+// ------- Dispatch -----------------------------
+
+template <typename T>
+static void networkSort(T* numbers, std::size_t n)
+{
+    if (n < 2)
+    {
+        return;
+    }
+    if (n > static_cast<std::size_t>(sort::NETWORK_SORT_MAX))
+    {
+        sort::quickSort(numbers, numbers + n);
+        return;
+    }
+
+    sort::SimdLevel level{sort::simdLevel()};
+    if (level == sort::SimdLevel::Scalar)
+    {
+        // Without SIMD a scalar network does more work than insertion sort.
+        sort::insertionSort(numbers, numbers + n);
+        return;
+    }
+
+    std::size_t size{level == sort::SimdLevel::AVX2 ? 8U : 4U};
+    while (size < n)
+    {
+        size *= 2;
+    }
+
+    // Network works on a power of two block padded with maximum values.
+    T block[sort::NETWORK_SORT_MAX];
+    std::fill(std::copy(numbers, numbers + n, block), block + size,
+              sentinel<T>());
+    switch (level)
+    {
+#ifdef SORTING_NETWORKS_X86
+    case sort::SimdLevel::AVX2:
+        bitonicSortAvx2<typename SimdOps<T>::Avx2>(block,
+                                                   static_cast<int>(size));
+        break;
+    case sort::SimdLevel::SSE4:
+        bitonicSortSse4<typename SimdOps<T>::Sse4>(block,
+                                                   static_cast<int>(size));
+        break;
+#endif
+    default:
+        break;
+    }
+    std::copy(block, block + n, numbers);
+}
+
+template <typename T>
+static void bitonicMerge(const T* left, std::size_t nLeft, const T* right,
+                         std::size_t nRight, T* out)
+{
+    if (nLeft == 0 || nRight == 0)
+    {
+        std::copy(right, right + nRight, std::copy(left, left + nLeft, out));
+        return;
+    }
+
+    switch (sort::simdLevel())
+    {
+#ifdef SORTING_NETWORKS_X86
+    case sort::SimdLevel::AVX2:
+        bitonicMergeAvx2<typename SimdOps<T>::Avx2>(left, nLeft, right, nRight,
+                                                    out);
+        break;
+    case sort::SimdLevel::SSE4:
+        bitonicMergeSse4<typename SimdOps<T>::Sse4>(left, nLeft, right, nRight,
+                                                    out);
+        break;
+#endif
+    default:
+        std::merge(left, left + nLeft, right, right + nRight, out);
+        break;
+    }
+}
+
+// ------- Sorting networks -----------------------------
+
+void sort::networkSort(int* numbers, std::size_t n)
+{
+    ::networkSort(numbers, n);
+}
+
+void sort::networkSort(float* numbers, std::size_t n)
+{
+    ::networkSort(numbers, n);
+}
+
+void sort::bitonicMerge(const int* left, std::size_t nLeft, const int* right,
+                        std::size_t nRight, int* out)
+{
+    ::bitonicMerge(left, nLeft, right, nRight, out);
+}
+
+void sort::bitonicMerge(const float* left, std::size_t nLeft,
+                        const float* right, std::size_t nRight, float* out)
+{
+    ::bitonicMerge(left, nLeft, right, nRight, out);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+
+namespace sort
+{
+
+/**
+ * @brief Instruction set used by the sorting network kernels.
+ *
+ */
+enum class SimdLevel
+{
+    Scalar,
+    SSE4,
+    AVX2
+};
+
+/**
+ * @brief Largest block sorted by a single sorting network.
+ *
+ */
+constexpr int NETWORK_SORT_MAX{64};
+
+/**
+ * @brief Get instruction set used by the sorting network kernels.
+ *
+ * @details Detected once from the CPU the program runs on, so the same binary
+ * uses AVX2 where available and falls back to SSE4.1 or scalar code on older
+ * hosts.
+ *
+ * @return `SimdLevel` Instruction set in use.
+ */
+SimdLevel simdLevel();
+
+/**
+ * @brief Select instruction set used by the sorting network kernels.
+ *
+ * @details Allows to force a lower level, e.g. to compare kernels. Levels not
+ * supported by the CPU are lowered to the best supported one.
+ *
+ * @param level Requested instruction set.
+ * @return `SimdLevel` Instruction set in use after the call.
+ */
+SimdLevel setSimdLevel(SimdLevel level);
+
+/**
+ * @brief Sorting network for a small array of integers.
+ *
+ * @details Blocks of up to `NETWORK_SORT_MAX` elements are padded to a power
+ * of two and sorted with a bitonic sorting network, which has no data
+ * dependent branches. Compare-exchange steps run on 8 (AVX2) or 4 (SSE4.1)
+ * lanes at once. Without SIMD support blocks are sorted with
+ * `sort::insertionSort`, longer arrays with `sort::quickSort`.
+ *
+ * Example usage:
+ * @code
+ * int block[12]{5, 3, 9, 1, 0, 4, 8, 7, 2, 6, 11, 10};
+ * sort::networkSort(block, 12);
+ * @endcode
+ *
+ * @param numbers Pointer to array of integers.
+ * @param n Number of elements in the array.
+ */
+void networkSort(int* numbers, std::size_t n);
+
+/**
+ * @brief Sorting network for a small array of floats.
+ *
+ * @details Same as the integer version. Order of NaN values is unspecified.
+ *
+ * @param numbers Pointer to array of floats.
+ * @param n Number of elements in the array.
+ */
+void networkSort(float* numbers, std::size_t n);
+
+/**
+ * @brief Merge two sorted arrays of integers with a bitonic merge network.
+ *
+ * @details Vectorized merge: a register holding the largest elements seen so
+ * far is merged with the next block from the input with the smaller head by
+ * a bitonic merge network, the lower half goes to the output. Only one branch
+ * per block is data dependent. Without SIMD support it is a regular scalar
+ * merge. Output must not overlap the inputs.
+ *
+ * @param left Pointer to first sorted array.
+ * @param nLeft Number of elements in the first array.
+ * @param right Pointer to second sorted array.
+ * @param nRight Number of elements in the second array.
+ * @param out Pointer to array of `nLeft + nRight` integers for the result.
+ */
+void bitonicMerge(const int* left, std::size_t nLeft, const int* right,
+                  std::size_t nRight, int* out);
+
+/**
+ * @brief Merge two sorted arrays of floats with a bitonic merge network.
+ *
+ * @details Same as the integer version. Order of NaN values is unspecified.
+ *
+ * @param left Pointer to first sorted array.
+ * @param nLeft Number of elements in the first array.
+ * @param right Pointer to second sorted array.
+ * @param nRight Number of elements in the second array.
+ * @param out Pointer to array of `nLeft + nRight` floats for the result.
+ */
+void bitonicMerge(const float* left, std::size_t nLeft, const float* right,
+                  std::size_t nRight, float* out);
+} // namespace sort
@@ -0,0 +1,49 @@
+#include "Algorithms/SortingStats.hpp"
+
+#include <sstream>
+
+std::string sort::SortStats::report() const
+{
+    std::ostringstream out;
+    out << "comparisons:   " << comparisons << '\n'
+        << "swaps:         " << swaps << '\n'
+        << "moves:         " << moves << '\n'
+        << "max depth:     " << maxDepth << '\n'
+        << "scratch bytes: " << scratchBytes << '\n';
+    return out.str();
+}
+
+sort::SortStats sort::sortStats()
+{
+    const sort_impl::SortCounters& counters{*sort_impl::activeCounters()};
+    SortStats stats;
+    stats.comparisons = counters.comparisons.load(std::memory_order_relaxed);
+    stats.swaps = counters.swaps.load(std::memory_order_relaxed);
+    stats.moves = counters.moves.load(std::memory_order_relaxed);
+    stats.maxDepth = counters.maxDepth.load(std::memory_order_relaxed);
+    stats.scratchBytes = counters.scratchBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void sort::resetSortStats()
+{
+    sort_impl::SortCounters& counters{*sort_impl::activeCounters()};
+    counters.comparisons.store(0, std::memory_order_relaxed);
+    counters.swaps.store(0, std::memory_order_relaxed);
+    counters.moves.store(0, std::memory_order_relaxed);
+    counters.maxDepth.store(0, std::memory_order_relaxed);
+    counters.scratchBytes.store(0, std::memory_order_relaxed);
+}
+
+sort_impl::SortCounters*& sort_impl::activeCounters()
+{
+    thread_local SortCounters counters;
+    thread_local SortCounters* active{&counters};
+    return active;
+}
+
+std::size_t& sort_impl::recursionDepth()
+{
+    thread_local std::size_t depth{0};
+    return depth;
+}
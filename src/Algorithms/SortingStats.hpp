@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace sort
+{
+
+/**
+ * @brief Whether the sorts count their work into `sort::sortStats()`.
+ *
+ * @details Set by compiling with `SORTING_INSTRUMENTATION` defined, e.g. by
+ * linking `AlgorithmsInstrumented` instead of `Algorithms`. Without it every
+ * counting hook is an empty inline function and the sorts compile to the
+ * same code as before. All translation units of a program have to agree on
+ * the setting.
+ */
+#ifdef SORTING_INSTRUMENTATION
+constexpr bool INSTRUMENTATION_ENABLED{true};
+#else
+constexpr bool INSTRUMENTATION_ENABLED{false};
+#endif
+
+/**
+ * @brief Work done by the sorts called from a thread.
+ *
+ * @details Counters are summed over all sorts since the last
+ * `sort::resetSortStats()`. Work that parallel sorts hand to helper threads
+ * is counted for the calling thread. All counters stay zero unless
+ * `sort::INSTRUMENTATION_ENABLED` is set.
+ *
+ * Example usage:
+ * @code
+ * sort::resetSortStats();
+ * sort::quickSort(values.begin(), values.end());
+ * std::cout << sort::sortStats().report();
+ * @endcode
+ */
+struct SortStats
+{
+    /**
+     * @brief Calls of the compare function, or character comparisons of the
+     * string sorts.
+     *
+     */
+    std::uint64_t comparisons{0};
+
+    /**
+     * @brief Swaps of two elements.
+     *
+     */
+    std::uint64_t swaps{0};
+
+    /**
+     * @brief Elements moved or copied outside of swaps, e.g. by merges,
+     * insertion shifts, heap sifts and radix scatters.
+     *
+     */
+    std::uint64_t moves{0};
+
+    /**
+     * @brief Deepest nesting of recursive calls, iterative sorts stay at 0.
+     *
+     */
+    std::size_t maxDepth{0};
+
+    /**
+     * @brief Bytes of scratch memory allocated, buffers passed in by the
+     * caller are not counted unless they have to grow.
+     *
+     */
+    std::uint64_t scratchBytes{0};
+
+    /**
+     * @brief Format the counters as a table, one counter per line.
+     *
+     * @return `std::string` Human readable report.
+     */
+    std::string report() const;
+};
+
+/**
+ * @brief Get the work done by the sorts called from this thread.
+ *
+ * @return `sort::SortStats` Counters since the last reset.
+ */
+SortStats sortStats();
+
+/**
+ * @brief Set the counters of this thread back to zero.
+ *
+ */
+void resetSortStats();
+} // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief Shared counters behind `sort::SortStats`.
+ *
+ * @details Atomic, so helper threads of a parallel sort can count into the
+ * counters of the thread that called it.
+ */
+struct SortCounters
+{
+    std::atomic<std::uint64_t> comparisons{0};
+    std::atomic<std::uint64_t> swaps{0};
+    std::atomic<std::uint64_t> moves{0};
+    std::atomic<std::size_t> maxDepth{0};
+    std::atomic<std::uint64_t> scratchBytes{0};
+};
+
+/**
+ * @brief Get the counters the sorts running on this thread count into.
+ *
+ * @return `SortCounters*&` Counters of this thread unless a
+ * `sort_impl::CountersScope` redirected them.
+ */
+SortCounters*& activeCounters();
+
+/**
+ * @brief Get the recursion depth of the sort running on this thread.
+ *
+ * @return `std::size_t&` Number of active `sort_impl::DepthGuard` objects.
+ */
+std::size_t& recursionDepth();
+
+/**
+ * @brief Add to the comparison counter.
+ *
+ * @param count Number of comparisons.
+ */
+inline void countComparisons(std::uint64_t count)
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED)
+    {
+        activeCounters()->comparisons.fetch_add(count,
+                                                std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Add to the move counter.
+ *
+ * @param count Number of moved elements.
+ */
+inline void countMoves(std::uint64_t count)
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED)
+    {
+        activeCounters()->moves.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Add to the scratch memory counter.
+ *
+ * @param bytes Number of allocated bytes.
+ */
+inline void countScratch(std::uint64_t bytes)
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED)
+    {
+        activeCounters()->scratchBytes.fetch_add(bytes,
+                                                 std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Swap the elements two iterators point to and count the swap.
+ *
+ * @tparam ForwardIt1 Forward iterator type.
+ * @tparam ForwardIt2 Forward iterator type.
+ * @param a Iterator to the first element.
+ * @param b Iterator to the second element.
+ */
+template <typename ForwardIt1, typename ForwardIt2>
+void iterSwap(ForwardIt1 a, ForwardIt2 b)
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED)
+    {
+        activeCounters()->swaps.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::iter_swap(a, b);
+}
+
+/**
+ * @brief Compare function wrapper counting its calls.
+ *
+ * @details Keeps a pointer to the counters of the thread that started the
+ * sort, so calls from helper threads are counted there as well.
+ *
+ * @tparam Compare Wrapped compare function type.
+ */
+template <typename Compare>
+class CountingCompare
+{
+  public:
+    CountingCompare(Compare comp, SortCounters* counters)
+        : m_Comp{std::move(comp)}, m_Counters{counters}
+    {
+    }
+
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b)
+    {
+        m_Counters->comparisons.fetch_add(1, std::memory_order_relaxed);
+        return m_Comp(std::forward<A>(a), std::forward<B>(b));
+    }
+
+    template <typename A, typename B>
+    bool operator()(A&& a, B&& b) const
+    {
+        m_Counters->comparisons.fetch_add(1, std::memory_order_relaxed);
+        return m_Comp(std::forward<A>(a), std::forward<B>(b));
+    }
+
+  private:
+    Compare m_Comp;
+    SortCounters* m_Counters;
+};
+
+template <typename Compare>
+struct IsCountingCompare : std::false_type
+{
+};
+
+template <typename Compare>
+struct IsCountingCompare<CountingCompare<Compare>> : std::true_type
+{
+};
+
+/**
+ * @brief Wrap a compare function to count its calls.
+ *
+ * @details Public sorts wrap their compare function once on entry. Compare
+ * functions that already count, e.g. when one sort falls back to another,
+ * and all compare functions with instrumentation disabled are returned
+ * unchanged by reference.
+ *
+ * @tparam Compare Compare function type.
+ * @param comp Compare function.
+ * @return `CountingCompare<Compare>` or `Compare&` Compare function to use.
+ */
+template <typename Compare>
+decltype(auto) countingCompare(Compare& comp)
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED &&
+                  !IsCountingCompare<Compare>::value)
+    {
+        return CountingCompare<Compare>{comp, activeCounters()};
+    }
+    else
+    {
+        return comp;
+    }
+}
+
+/**
+ * @brief Scope of one level of recursion.
+ *
+ * @details Recursive functions create one at entry, the deepest nesting is
+ * recorded as `sort::SortStats::maxDepth`.
+ */
+class DepthGuard
+{
+  public:
+    DepthGuard()
+    {
+        if constexpr (sort::INSTRUMENTATION_ENABLED)
+        {
+            std::size_t depth{++recursionDepth()};
+            std::atomic<std::size_t>& maxDepth{activeCounters()->maxDepth};
+            std::size_t deepest{maxDepth.load(std::memory_order_relaxed)};
+            while (deepest < depth &&
+                   !maxDepth.compare_exchange_weak(deepest, depth,
+                                                   std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    ~DepthGuard()
+    {
+        if constexpr (sort::INSTRUMENTATION_ENABLED)
+        {
+            --recursionDepth();
+        }
+    }
+
+    DepthGuard(const DepthGuard&) = delete;
+    DepthGuard& operator=(const DepthGuard&) = delete;
+};
+
+/**
+ * @brief Counters and recursion depth of a thread handing work to helpers.
+ *
+ */
+struct CounterContext
+{
+    SortCounters* counters{nullptr};
+    std::size_t depth{0};
+};
+
+/**
+ * @brief Get the context to pass to helper threads.
+ *
+ * @return `CounterContext` Counters and depth of this thread.
+ */
+inline CounterContext counterContext()
+{
+    if constexpr (sort::INSTRUMENTATION_ENABLED)
+    {
+        return {activeCounters(), recursionDepth()};
+    }
+    else
+    {
+        return {};
+    }
+}
+
+/**
+ * @brief Counts the work of a helper thread for the thread it works for.
+ *
+ * @details Tasks of parallel sorts create one first thing with the context
+ * captured when they were started.
+ */
+class CountersScope
+{
+  public:
+    explicit CountersScope(const CounterContext& context)
+    {
+        if constexpr (sort::INSTRUMENTATION_ENABLED)
+        {
+            m_Saved = {activeCounters(), recursionDepth()};
+            activeCounters() = context.counters;
+            recursionDepth() = context.depth;
+        }
+    }
+
+    ~CountersScope()
+    {
+        if constexpr (sort::INSTRUMENTATION_ENABLED)
+        {
+            activeCounters() = m_Saved.counters;
+            recursionDepth() = m_Saved.depth;
+        }
+    }
+
+    CountersScope(const CountersScope&) = delete;
+    CountersScope& operator=(const CountersScope&) = delete;
+
+  private:
+    CounterContext m_Saved;
+};
+} // namespace sort_impl
@@ -0,0 +1,485 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/SortingStats.hpp"
+
+namespace sort
+{
+
+/**
+ * @brief Multikey quick sort for a range of strings.
+ *
+ * @details Bentley-Sedgewick three-way radix quick sort. Strings are
+ * partitioned by a single character into smaller, equal and greater parts,
+ * only the equal part moves on to the next character. Characters of a common
+ * prefix are therefore looked at once per partitioning step instead of once
+ * per comparison, and sorting costs `O(D + n log n)` character reads, `D`
+ * being the total length of the distinguishing prefixes. Elements are
+ * swapped in place, character data is never copied. Short ranges are
+ * finished with insertion sort. Orders like `std::string::operator<`
+ * (bytes compared as `unsigned char`). Not stable.
+ *
+ * Example usage:
+ * @code
+ * std::vector<std::string> urls{"https://b.org", "https://a.org"};
+ * sort::multikeyQuickSort(urls.begin(), urls.end());
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator to `std::string`,
+ * `std::string_view` or other type convertible to `std::string_view`.
+ * @param first Iterator to the first string.
+ * @param last Iterator to one past the last string.
+ */
+template <typename RandomIt>
+void multikeyQuickSort(RandomIt first, RandomIt last);
+
+/**
+ * @brief Multikey quick sort for a range of strings with LCP output.
+ *
+ * @details Same as `sort::multikeyQuickSort(first, last)`, also fills the
+ * longest common prefix array of the result: `lcp[i]` is the length of the
+ * common prefix of the sorted strings `i - 1` and `i`, `lcp[0]` is 0. It is
+ * recorded during partitioning at no extra character reads, which makes it
+ * cheap to e.g. bulk load the sorted strings into a prefix tree.
+ *
+ * @tparam RandomIt Random access iterator to strings.
+ * @param first Iterator to the first string.
+ * @param last Iterator to one past the last string.
+ * @param lcp Resized to the number of strings and filled with LCP values.
+ */
+template <typename RandomIt>
+void multikeyQuickSort(RandomIt first, RandomIt last,
+                       std::vector<std::size_t>& lcp);
+
+/**
+ * @brief MSD radix sort for a range of strings.
+ *
+ * @details Distributes strings into 257 buckets by the character at the
+ * current depth (one for strings that end there), then sorts each bucket by
+ * the next character. The characters of a step are read once into a buffer
+ * of `n` 16-bit values, counting and permuting work on it instead of
+ * dereferencing every string again. Strings are permuted in place (American
+ * flag sort) and their character data is never copied. Strings that all
+ * share a character skip their whole common prefix in one pass. Buckets
+ * smaller than `MSD_RADIX_THRESHOLD` are handed over to multikey quick sort,
+ * where the 257 counters would cost more than they save. Recursion continues
+ * in the largest bucket without a new stack frame, so the stack depth stays
+ * `O(log n)` also for long common prefixes. Not stable.
+ *
+ * Example usage:
+ * @code
+ * std::vector<std::string_view> keys{"key:42", "key:7", "id:1"};
+ * sort::msdRadixSort(keys.begin(), keys.end());
+ * @endcode
+ *
+ * @tparam RandomIt Random access iterator to `std::string`,
+ * `std::string_view` or other type convertible to `std::string_view`.
+ * @param first Iterator to the first string.
+ * @param last Iterator to one past the last string.
+ */
+template <typename RandomIt>
+void msdRadixSort(RandomIt first, RandomIt last);
+
+/**
+ * @brief MSD radix sort for a range of strings with LCP output.
+ *
+ * @details Same as `sort::msdRadixSort(first, last)`, also fills the longest
+ * common prefix array of the result like
+ * `sort::multikeyQuickSort(first, last, lcp)`.
+ *
+ * @tparam RandomIt Random access iterator to strings.
+ * @param first Iterator to the first string.
+ * @param last Iterator to one past the last string.
+ * @param lcp Resized to the number of strings and filled with LCP values.
+ */
+template <typename RandomIt>
+void msdRadixSort(RandomIt first, RandomIt last,
+                  std::vector<std::size_t>& lcp);
+} // namespace sort
+
+namespace sort_impl
+{
+
+/**
+ * @brief String ranges of this size are sorted with insertion sort.
+ *
+ */
+constexpr std::ptrdiff_t STRING_INSERTION_SORT_THRESHOLD{16};
+
+/**
+ * @brief String ranges smaller than this are not sorted by MSD radix sort.
+ *
+ */
+constexpr std::ptrdiff_t MSD_RADIX_THRESHOLD{64};
+
+/**
+ * @brief Number of buckets of a MSD radix sort step, one per character plus
+ * one for strings ending at the current depth.
+ *
+ */
+constexpr int STRING_BUCKETS{257};
+
+// Character at `depth` shifted by one, 0 if the string is shorter.
+template <typename T>
+int charAt(const T& string, std::size_t depth);
+
+// Length of the prefix shared by all strings, which share `depth` already.
+template <typename RandomIt>
+std::size_t commonPrefix(RandomIt first, RandomIt last, std::size_t depth);
+
+template <typename RandomIt>
+void stringInsertionSort(RandomIt first, RandomIt last, std::size_t depth,
+                         std::size_t* lcp);
+
+template <typename RandomIt>
+void multikeyQuickSort(RandomIt first, RandomIt last, std::size_t depth,
+                       std::size_t* lcp);
+
+template <typename RandomIt>
+void msdRadixSort(RandomIt first, RandomIt last, std::size_t depth,
+                  std::size_t* lcp, std::uint16_t* oracle);
+} // namespace sort_impl
+
+// ------- Multikey Quick Sort -----------------------------
+
+template <typename RandomIt>
+void sort::multikeyQuickSort(RandomIt first, RandomIt last)
+{
+    sort_impl::multikeyQuickSort(first, last, 0, nullptr);
+}
+
+template <typename RandomIt>
+void sort::multikeyQuickSort(RandomIt first, RandomIt last,
+                             std::vector<std::size_t>& lcp)
+{
+    lcp.assign(static_cast<std::size_t>(last - first), 0);
+    sort_impl::multikeyQuickSort(first, last, 0, lcp.data());
+}
+
+template <typename T>
+int sort_impl::charAt(const T& string, std::size_t depth)
+{
+    static_assert(std::is_convertible_v<const T&, std::string_view>,
+                  "Elements must be convertible to std::string_view!");
+
+    std::string_view view{string};
+    return depth < view.size()
+               ? static_cast<unsigned char>(view[depth]) + 1
+               : 0;
+}
+
+template <typename RandomIt>
+std::size_t sort_impl::commonPrefix(RandomIt first, RandomIt last,
+                                    std::size_t depth)
+{
+    // One pass over the range instead of one partitioning step per shared
+    // character.
+    std::string_view reference{*first};
+    std::size_t length{reference.size()};
+    for (RandomIt it{first + 1}; it != last && length > depth; ++it)
+    {
+        std::string_view current{*it};
+        auto end{std::min(length, current.size())};
+        length = static_cast<std::size_t>(
+            std::mismatch(reference.begin() + depth, reference.begin() + end,
+                          current.begin() + depth)
+                .first -
+            reference.begin());
+    }
+    return length;
+}
+
+template <typename RandomIt>
+void sort_impl::stringInsertionSort(RandomIt first, RandomIt last,
+                                    std::size_t depth, std::size_t* lcp)
+{
+    // All strings share a prefix of `depth` characters, only the rest is
+    // compared.
+    auto suffix{[depth](const auto& string) {
+        return std::string_view{string}.substr(depth);
+    }};
+    if (first == last)
+    {
+        return;
+    }
+    for (RandomIt i{first + 1}; i != last; ++i)
+    {
+        auto value{std::move(*i)};
+        RandomIt hole{i};
+        for (; hole != first && suffix(value) < suffix(*(hole - 1)); --hole)
+        {
+            *hole = std::move(*(hole - 1));
+        }
+        *hole = std::move(value);
+        sort_impl::countComparisons(static_cast<std::uint64_t>(i - hole) +
+                                    (hole != first ? 1 : 0));
+        sort_impl::countMoves(static_cast<std::uint64_t>(i - hole) + 2);
+    }
+
+    if (lcp != nullptr)
+    {
+        for (std::ptrdiff_t i{1}; i < last - first; ++i)
+        {
+            std::string_view previous{suffix(first[i - 1])};
+            std::string_view current{suffix(first[i])};
+            auto length{std::min(previous.size(), current.size())};
+            auto mismatch{std::mismatch(previous.begin(),
+                                        previous.begin() + length,
+                                        current.begin())};
+            lcp[i] = depth + static_cast<std::size_t>(mismatch.first -
+                                                      previous.begin());
+        }
+    }
+}
+
+template <typename RandomIt>
+void sort_impl::multikeyQuickSort(RandomIt first, RandomIt last,
+                                  std::size_t depth, std::size_t* lcp)
+{
+    sort_impl::DepthGuard guard;
+    while (last - first > STRING_INSERTION_SORT_THRESHOLD)
+    {
+        // Median of three characters as pivot.
+        auto n{last - first};
+        sort_impl::countComparisons(static_cast<std::uint64_t>(n));
+        int a{charAt(first[0], depth)};
+        int b{charAt(first[n / 2], depth)};
+        int c{charAt(first[n - 1], depth)};
+        int pivot{std::max(std::min(a, b), std::min(std::max(a, b), c))};
+
+        // Three-way partition by the character at `depth`:
+        // [first, less) < pivot, [less, greater) == pivot, [greater, last) >
+        RandomIt less{first};
+        RandomIt greater{last};
+        for (RandomIt it{first}; it < greater;)
+        {
+            int current{charAt(*it, depth)};
+            if (current < pivot)
+            {
+                sort_impl::iterSwap(less++, it++);
+            }
+            else if (current > pivot)
+            {
+                sort_impl::iterSwap(it, --greater);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // Neighbours from different parts agree on the first `depth`
+        // characters only.
+        if (lcp != nullptr)
+        {
+            if (less != first)
+            {
+                lcp[less - first] = depth;
+            }
+            if (greater != last)
+            {
+                lcp[greater - first] = depth;
+            }
+        }
+
+        if (pivot == 0)
+        {
+            // The equal part holds strings that end at `depth`, they are
+            // equal and done.
+            if (lcp != nullptr)
+            {
+                std::fill(lcp + (less - first) + 1, lcp + (greater - first),
+                          depth);
+            }
+            sort_impl::multikeyQuickSort(first, less, depth, lcp);
+            lcp = lcp != nullptr ? lcp + (greater - first) : nullptr;
+            first = greater;
+            continue;
+        }
+
+        // Recurse into the two smaller parts and loop over the largest, so
+        // the stack depth stays within O(log n).
+        auto lessSize{less - first};
+        auto equalSize{greater - less};
+        auto greaterSize{last - greater};
+        if (equalSize == n)
+        {
+            // All strings share the character, skip their whole common
+            // prefix at once.
+            depth = sort_impl::commonPrefix(first, last, depth + 1);
+            continue;
+        }
+        std::size_t* lessLcp{lcp};
+        std::size_t* equalLcp{lcp != nullptr ? lcp + lessSize : nullptr};
+        std::size_t* greaterLcp{lcp != nullptr ? lcp + lessSize + equalSize
+                                               : nullptr};
+        if (equalSize >= lessSize && equalSize >= greaterSize)
+        {
+            sort_impl::multikeyQuickSort(first, less, depth, lessLcp);
+            sort_impl::multikeyQuickSort(greater, last, depth, greaterLcp);
+            first = less;
+            last = greater;
+            lcp = equalLcp;
+            ++depth;
+        }
+        else if (lessSize >= greaterSize)
+        {
+            sort_impl::multikeyQuickSort(less, greater, depth + 1, equalLcp);
+            sort_impl::multikeyQuickSort(greater, last, depth, greaterLcp);
+            last = less;
+        }
+        else
+        {
+            sort_impl::multikeyQuickSort(first, less, depth, lessLcp);
+            sort_impl::multikeyQuickSort(less, greater, depth + 1, equalLcp);
+            first = greater;
+            lcp = greaterLcp;
+        }
+    }
+    sort_impl::stringInsertionSort(first, last, depth, lcp);
+}
+
+// ------- MSD Radix Sort -----------------------------
+
+template <typename RandomIt>
+void sort::msdRadixSort(RandomIt first, RandomIt last)
+{
+    std::vector<std::uint16_t> oracle(static_cast<std::size_t>(last - first));
+    sort_impl::countScratch(oracle.size() * sizeof(std::uint16_t));
+    sort_impl::msdRadixSort(first, last, 0, nullptr, oracle.data());
+}
+
+template <typename RandomIt>
+void sort::msdRadixSort(RandomIt first, RandomIt last,
+                        std::vector<std::size_t>& lcp)
+{
+    lcp.assign(static_cast<std::size_t>(last - first), 0);
+    std::vector<std::uint16_t> oracle(lcp.size());
+    sort_impl::countScratch(oracle.size() * sizeof(std::uint16_t));
+    sort_impl::msdRadixSort(first, last, 0, lcp.data(), oracle.data());
+}
+
+template <typename RandomIt>
+void sort_impl::msdRadixSort(RandomIt first, RandomIt last, std::size_t depth,
+                             std::size_t* lcp, std::uint16_t* oracle)
+{
+    using Difference = typename std::iterator_traits<RandomIt>::difference_type;
+
+    sort_impl::DepthGuard guard;
+    while (last - first >= MSD_RADIX_THRESHOLD)
+    {
+        // Read the character of every string once, counting and permuting
+        // work on the compact copy instead of following string pointers.
+        std::array<Difference, STRING_BUCKETS> bucketEnd{};
+        for (Difference i{0}; i < last - first; ++i)
+        {
+            oracle[i] = static_cast<std::uint16_t>(charAt(first[i], depth));
+            ++bucketEnd[oracle[i]];
+        }
+
+        // Turn counts into bucket boundaries, `next` is the first position
+        // of a bucket that does not hold a string of that bucket yet.
+        std::array<Difference, STRING_BUCKETS> next{};
+        Difference offset{0};
+        int largest{0};
+        for (int bucket{0}; bucket < STRING_BUCKETS; ++bucket)
+        {
+            next[bucket] = offset;
+            offset += bucketEnd[bucket];
+            if (bucketEnd[bucket] > bucketEnd[largest])
+            {
+                largest = bucket;
+            }
+            bucketEnd[bucket] = offset;
+        }
+        if (bucketEnd[largest] - next[largest] == last - first)
+        {
+            // Single bucket, all strings share the character.
+            if (largest == 0)
+            {
+                if (lcp != nullptr)
+                {
+                    std::fill(lcp + 1, lcp + (last - first), depth);
+                }
+                return;
+            }
+            depth = sort_impl::commonPrefix(first, last, depth + 1);
+            continue;
+        }
+
+        // American flag sort: swap every string into its bucket, following
+        // the cycles of the permutation.
+        std::array<Difference, STRING_BUCKETS> bucketStart{next};
+        for (int bucket{0}; bucket < STRING_BUCKETS; ++bucket)
+        {
+            while (next[bucket] < bucketEnd[bucket])
+            {
+                Difference position{next[bucket]};
+                int target{oracle[position]};
+                while (target != bucket)
+                {
+                    Difference swapPosition{next[target]++};
+                    sort_impl::iterSwap(first + position, first + swapPosition);
+                    std::swap(oracle[position], oracle[swapPosition]);
+                    target = oracle[position];
+                }
+                ++next[bucket];
+            }
+        }
+
+        for (int bucket{0}; bucket < STRING_BUCKETS; ++bucket)
+        {
+            Difference start{bucketStart[bucket]};
+            Difference end{bucketEnd[bucket]};
+            if (start == end)
+            {
+                continue;
+            }
+            if (lcp != nullptr)
+            {
+                if (start != 0)
+                {
+                    lcp[start] = depth;
+                }
+                if (bucket == 0)
+                {
+                    // Strings ending at `depth` are equal.
+                    std::fill(lcp + start + 1, lcp + end, depth);
+                }
+            }
+            if (bucket != 0 && bucket != largest && end - start > 1)
+            {
+                sort_impl::msdRadixSort(first + start, first + end,
+                                        depth + 1,
+                                        lcp != nullptr ? lcp + start
+                                                       : nullptr,
+                                        oracle + start);
+            }
+        }
+
+        // Continue with the largest bucket without recursion, every other
+        // bucket has at most half of the strings.
+        if (largest == 0)
+        {
+            return;
+        }
+        if (lcp != nullptr)
+        {
+            lcp += bucketStart[largest];
+        }
+        oracle += bucketStart[largest];
+        last = first + bucketEnd[largest];
+        first += bucketStart[largest];
+        ++depth;
+    }
+    sort_impl::multikeyQuickSort(first, last, depth, lcp);
+}
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 /**
@@ -15,7 +20,26 @@
  * @details Dynamic array is a container that dynamically allocates or
  * deallocates memory depending on the number of elements inserted.
  * It allows for access to its elements in constant time `O(1)`. Insert and
- * delete works with `O(n)` complexity.
+ * delete works with `O(n)` complexity, inserting at and removing from the end
+ * as well as `swapRemove` in amortized `O(1)`.
+ *
+ * Capacity doubles when the array is full and halves when it is less than a
+ * quarter full, so alternating inserts and removes never reallocate on every
+ * call. `reserve` and `shrinkToFit` set the capacity explicitly.
+ *
+ * Storage is allocated uninitialized, elements are constructed in place when
+ * inserted and destroyed when removed. On growth elements are moved to the
+ * new storage if their move constructor is `noexcept` (or they cannot be
+ * copied) and copied otherwise, so a throwing copy leaves the array
+ * unchanged. Trivially copyable elements live in `malloc` storage that grows
+ * and shrinks with `realloc`, which extends blocks in place when it can and
+ * on Linux remaps large blocks with `mremap` instead of copying them.
+ *
+ * Other allocators, such as `std::pmr::polymorphic_allocator` over a
+ * monotonic arena or an allocator of huge page aligned memory, allocate the
+ * storage and construct the elements instead, so elements that use an
+ * allocator themselves get the one of the array. Copies and moves pass the
+ * allocator on as `std::allocator_traits` says, like standard containers.
  *
  *
  * Example usage:
@@ -25,12 +49,24 @@
  * int b{dynamicArray[0]};
  * @endcode
  *
+ * @code
+ * // Request scoped array, released with the arena at once.
+ * std::pmr::monotonic_buffer_resource arena;
+ * DynamicArray<int, std::pmr::polymorphic_allocator<int>> scoped{&arena};
+ * scoped.insert(1);
+ * @endcode
+ *
  *
  * @tparam T Type of the stored values.
+ * @tparam Allocator Allocator of the storage.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class DynamicArray
 {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename AllocatorTraits::value_type, T>,
+                  "Allocator must allocate the stored type!");
+
   public:
     /**
      * @brief Type used for indexing and size definition.
@@ -42,7 +78,19 @@ class DynamicArray
      * @brief Construct a new DynamicArray object.
      *
      */
-    DynamicArray() : m_Size{0}, m_Capacity{2}, m_Data{std::make_unique<T[]>(0)}
+    DynamicArray() : DynamicArray(Allocator())
+    {
+    }
+
+    /**
+     * @brief Construct a new DynamicArray object that allocates with the
+     * given allocator.
+     *
+     * @param allocator Allocator of the storage.
+     */
+    explicit DynamicArray(const Allocator& allocator)
+        : m_Allocator{allocator}, m_Size{0}, m_Capacity{2},
+          m_Data{allocate(2)}
     {
     }
 
@@ -50,64 +98,109 @@ class DynamicArray
      * @brief Construct a new DynamicArray object from initializer list.
      *
      * @param list Initializer list.
+     * @param allocator Allocator of the storage.
      */
-    DynamicArray(std::initializer_list<T> list)
-        : m_Size{static_cast<size_type>(list.size())},
-          m_Capacity{static_cast<size_type>(list.size())},
-          m_Data{std::make_unique<T[]>(list.size())}
+    DynamicArray(std::initializer_list<T> list,
+                 const Allocator& allocator = Allocator())
+        : DynamicArray(list.begin(), static_cast<size_type>(list.size()),
+                       allocator)
     {
-        std::copy(list.begin(), list.end(), m_Data.get());
     }
 
-    DynamicArray(const DynamicArray<T>& array)
+    DynamicArray(const DynamicArray<T, Allocator>& array)
+        : DynamicArray(array.begin(), array.m_Size,
+                       AllocatorTraits::select_on_container_copy_construction(
+                           array.m_Allocator))
     {
-        *this = array;
     }
 
-    DynamicArray<T>& operator=(const DynamicArray<T>& array)
+    DynamicArray<T, Allocator>& operator=(
+        const DynamicArray<T, Allocator>& array)
     {
-        m_Capacity = array.m_Capacity;
-        m_Size = array.m_Size;
-        m_Data = std::make_unique<T[]>(m_Size);
-        auto* p{array.m_Data.get()};
-        std::copy(p, p + array.m_Size, m_Data.get());
+        if (this != &array)
+        {
+            constexpr bool propagate{
+                AllocatorTraits::propagate_on_container_copy_assignment::value};
+            DynamicArray<T, Allocator> copy(array.begin(), array.m_Size,
+                                            propagate ? array.m_Allocator
+                                                      : m_Allocator);
+            release();
+            if constexpr (propagate)
+            {
+                m_Allocator = array.m_Allocator;
+            }
+            take(copy);
+        }
         return *this;
     }
 
-    DynamicArray(DynamicArray<T>&& array)
+    DynamicArray(DynamicArray<T, Allocator>&& array) noexcept
+        : m_Allocator{std::move(array.m_Allocator)}, m_Size{0},
+          m_Capacity{0}, m_Data{nullptr}
     {
-        *this = std::move(array);
+        take(array);
     }
 
     /**
      * @brief Destroy the DynamicArray object.
      *
      */
-    ~DynamicArray() = default;
+    ~DynamicArray()
+    {
+        release();
+    }
 
-    DynamicArray<T>& operator=(DynamicArray<T>&& array)
+    DynamicArray<T, Allocator>& operator=(
+        DynamicArray<T, Allocator>&& array) noexcept(
+        AllocatorTraits::propagate_on_container_move_assignment::value ||
+        AllocatorTraits::is_always_equal::value)
     {
-        m_Capacity = array.m_Capacity;
-        m_Size = array.m_Size;
-        m_Data = std::move(array.m_Data);
-        array.m_Size = 0;
-        array.m_Capacity = 0;
+        if (this == &array)
+        {
+            return *this;
+        }
+        constexpr bool propagate{
+            AllocatorTraits::propagate_on_container_move_assignment::value};
+        if constexpr (!propagate && !AllocatorTraits::is_always_equal::value)
+        {
+            // Storage of another allocator cannot be taken over.
+            if (m_Allocator != array.m_Allocator)
+            {
+                DynamicArray<T, Allocator> moved(
+                    std::make_move_iterator(array.begin()), array.m_Size,
+                    m_Allocator);
+                release();
+                take(moved);
+                return *this;
+            }
+        }
+        release();
+        if constexpr (propagate)
+        {
+            m_Allocator = std::move(array.m_Allocator);
+        }
+        take(array);
         return *this;
     }
 
-    bool operator==(const DynamicArray<T>& other)
+    bool operator==(const DynamicArray<T, Allocator>& other) const
     {
         if (m_Size != other.m_Size)
             return false;
-        for (int i{0}; i < m_Size; ++i)
+        // Equal objects have equal bytes only without padding or values like
+        // floating point zeros that compare equal with different bits.
+        if constexpr (std::has_unique_object_representations_v<T>)
+        {
+            return m_Size == 0 ||
+                   std::memcmp(m_Data, other.m_Data, m_Size * sizeof(T)) == 0;
+        }
+        else
         {
-            if (get(i) != other.get(i))
-                return false;
+            return std::equal(begin(), end(), other.begin());
         }
-        return true;
     }
 
-    bool operator!=(const DynamicArray<T>& other)
+    bool operator!=(const DynamicArray<T, Allocator>& other) const
     {
         return !(*this == other);
     }
@@ -119,12 +212,12 @@ class DynamicArray
      */
     T* begin()
     {
-        return m_Data.get();
+        return m_Data;
     }
 
     const T* begin() const
     {
-        return m_Data.get();
+        return m_Data;
     }
 
     /**
@@ -134,33 +227,129 @@ class DynamicArray
      */
     T* end()
     {
-        return m_Data.get() + m_Size;
+        return m_Data + m_Size;
     }
 
     const T* end() const
     {
-        return m_Data.get() + m_Size;
+        return m_Data + m_Size;
     }
 
     /**
      * @brief Inserts element to the array.
      *
-     * @details Allocates additional memory and copy array to new location if
-     * size equals capacity.
+     * @details Allocates additional memory and relocates the elements if size
+     * equals capacity.
      *
-     * @param element The element to be inserted.
+     * @param element The element to be copied into the array.
      */
-    void insert(T element);
+    void insert(const T& element)
+    {
+        emplace(element);
+    }
+
+    /**
+     * @brief Inserts element to the array.
+     *
+     * @details Same as `insert(const T&)`, the element is moved from.
+     *
+     * @param element The element to be moved into the array.
+     */
+    void insert(T&& element)
+    {
+        emplace(std::move(element));
+    }
+
+    /**
+     * @brief Construct an element in place at the end of the array.
+     *
+     * @details Arguments may refer to elements of the array, the new element
+     * is constructed before the others are relocated.
+     *
+     * @tparam Args Types of the constructor arguments.
+     * @param args Arguments forwarded to the constructor of `T`.
+     *
+     * @return `T&` Reference to the new element.
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
+    /**
+     * @brief Insert copies of a range of elements before an index.
+     *
+     * @details Allocates at most once. The elements from the index on are
+     * moved behind the inserted ones. The range must not point into the
+     * array.
+     *
+     * @tparam ForwardIt Forward iterator type.
+     * @param index Index the first inserted element gets, up to `size()`.
+     * @param first Iterator to the first element to insert.
+     * @param last Iterator to one past the last element to insert.
+     */
+    template <typename ForwardIt>
+    void insert(size_type index, ForwardIt first, ForwardIt last);
+
+    /**
+     * @brief Insert copies of a range of elements at the end of the array.
+     *
+     * @details Allocates at most once. Pass `std::move_iterator`s to move the
+     * elements instead. The range must not point into the array.
+     *
+     * @tparam ForwardIt Forward iterator type.
+     * @param first Iterator to the first element to insert.
+     * @param last Iterator to one past the last element to insert.
+     */
+    template <typename ForwardIt>
+    void append(ForwardIt first, ForwardIt last);
 
     /**
      * @brief Remove element at an index from the array.
      *
-     * @details Reduces container capacity if the container becomes half empty.
+     * @details Reduces container capacity if the container becomes less than
+     * a quarter full.
      *
      * @param index Index of the element to remove.
      */
     void remove(size_type index);
 
+    /**
+     * @brief Remove the elements in the index range `[first, last)`.
+     *
+     * @details Moves the elements behind the range once, reduces container
+     * capacity like `remove(size_type)`.
+     *
+     * @param first Index of the first element to remove.
+     * @param last Index of one past the last element to remove.
+     */
+    void remove(size_type first, size_type last);
+
+    /**
+     * @brief Remove element at an index by moving the last element into its
+     * place.
+     *
+     * @details Works in `O(1)` but does not keep the order of the elements,
+     * reduces container capacity like `remove(size_type)`.
+     *
+     * @param index Index of the element to remove.
+     */
+    void swapRemove(size_type index);
+
+    /**
+     * @brief Grow capacity to at least the given number of elements.
+     *
+     * @details Never reduces capacity. Removing elements may release the
+     * reserved storage again.
+     *
+     * @param capacity Number of elements to allocate storage for.
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * @brief Reduce capacity to the number of elements.
+     *
+     */
+    void shrinkToFit();
+
     /**
      * @brief Access element at given index.
      *
@@ -234,47 +423,336 @@ class DynamicArray
         return m_Size == 0;
     }
 
+    /**
+     * @brief Get a copy of the allocator of the storage.
+     *
+     * @return `Allocator` Allocator of the storage.
+     */
+    Allocator getAllocator() const
+    {
+        return m_Allocator;
+    }
+
   private:
+    Allocator m_Allocator;
     size_type m_Size;
     size_type m_Capacity;
-    std::unique_ptr<T[]> m_Data;
+    T* m_Data;
+
+    template <typename InputIt>
+    DynamicArray(InputIt first, size_type n, const Allocator& allocator)
+        : m_Allocator{allocator}, m_Size{0}, m_Capacity{n},
+          m_Data{allocate(n)}
+    {
+        try
+        {
+            construct(first, first + n, m_Data);
+        }
+        catch (...)
+        {
+            deallocate(m_Data, m_Capacity);
+            throw;
+        }
+        m_Size = n;
+    }
+
+    /**
+     * @brief Whether the array allocates with `std::allocator`, which
+     * constructs elements with placement new.
+     *
+     */
+    static constexpr bool DEFAULT_ALLOCATOR{
+        std::is_same_v<Allocator, std::allocator<T>>};
+
+    /**
+     * @brief Whether the storage is resized with `realloc`.
+     *
+     * @details Trivially copyable elements may change address with their
+     * bytes, `malloc` storage is aligned for all types that are not
+     * over-aligned. Only replaces `std::allocator`, other allocators are
+     * always used.
+     */
+    static constexpr bool REALLOCATABLE{DEFAULT_ALLOCATOR &&
+                                        std::is_trivially_copyable_v<T> &&
+                                        alignof(T) <=
+                                            alignof(std::max_align_t)};
+
+    T* allocate(size_type n)
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+        if constexpr (REALLOCATABLE)
+        {
+            void* data{std::malloc(static_cast<std::size_t>(n) * sizeof(T))};
+            if (data == nullptr)
+            {
+                throw std::bad_alloc{};
+            }
+            return static_cast<T*>(data);
+        }
+        else
+        {
+            return AllocatorTraits::allocate(m_Allocator, n);
+        }
+    }
+
+    void deallocate(T* data, size_type n)
+    {
+        if constexpr (REALLOCATABLE)
+        {
+            std::free(data);
+        }
+        else if (data != nullptr)
+        {
+            AllocatorTraits::deallocate(m_Allocator, data, n);
+        }
+    }
+
+    /**
+     * @brief Construct copies of a range in uninitialized storage.
+     *
+     * @details Destroys the constructed elements if a constructor throws.
+     * `std::uninitialized_copy` does the same for `std::allocator` and copies
+     * trivially copyable elements with `memmove`.
+     *
+     * @return `T*` Pointer to one past the last constructed element.
+     */
+    template <typename InputIt>
+    T* construct(InputIt first, InputIt last, T* destination)
+    {
+        if constexpr (DEFAULT_ALLOCATOR)
+        {
+            return std::uninitialized_copy(first, last, destination);
+        }
+        else
+        {
+            T* current{destination};
+            try
+            {
+                for (; first != last; ++first, ++current)
+                {
+                    AllocatorTraits::construct(m_Allocator, current, *first);
+                }
+            }
+            catch (...)
+            {
+                destroy(destination, current);
+                throw;
+            }
+            return current;
+        }
+    }
+
+    void destroy(T* first, T* last) noexcept
+    {
+        if constexpr (DEFAULT_ALLOCATOR)
+        {
+            std::destroy(first, last);
+        }
+        else
+        {
+            for (; first != last; ++first)
+            {
+                AllocatorTraits::destroy(m_Allocator, first);
+            }
+        }
+    }
+
+    /**
+     * @brief Move or copy elements into uninitialized storage.
+     *
+     * @details Moves if that cannot throw or `T` cannot be copied, like
+     * `std::move_if_noexcept`.
+     */
+    void relocate(T* first, T* last, T* destination)
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>)
+        {
+            construct(std::make_move_iterator(first),
+                      std::make_move_iterator(last), destination);
+        }
+        else
+        {
+            construct(first, last, destination);
+        }
+    }
+
+    void release() noexcept
+    {
+        destroy(begin(), end());
+        deallocate(m_Data, m_Capacity);
+    }
+
+    /**
+     * @brief Take the storage of another array after releasing the own,
+     * leaving the other array empty.
+     *
+     */
+    void take(DynamicArray<T, Allocator>& array) noexcept
+    {
+        m_Size = std::exchange(array.m_Size, 0);
+        m_Capacity = std::exchange(array.m_Capacity, 0);
+        m_Data = std::exchange(array.m_Data, nullptr);
+    }
+
     void resize(size_type newCapacity);
+
+    /**
+     * @brief Make room for at least `n` elements, at least doubling capacity
+     * if it grows.
+     *
+     */
+    void grow(size_type n);
+
+    /**
+     * @brief Halve capacity until the array is at least a quarter full.
+     *
+     */
+    void shrink();
 };
 
-template <typename T>
-void DynamicArray<T>::insert(T element)
+template <typename T, typename Allocator>
+template <typename... Args>
+T& DynamicArray<T, Allocator>::emplace(Args&&... args)
 {
-    if (m_Size == m_Capacity)
-        resize(m_Capacity * 2);
-    m_Data[m_Size++] = element;
+    if (m_Size < m_Capacity)
+    {
+        T* element{m_Data + m_Size};
+        AllocatorTraits::construct(m_Allocator, element,
+                                   std::forward<Args>(args)...);
+        ++m_Size;
+        return *element;
+    }
+
+    size_type newCapacity{std::max<size_type>(2, m_Capacity * 2)};
+    if constexpr (REALLOCATABLE)
+    {
+        // Arguments may refer to the storage `realloc` releases.
+        T value(std::forward<Args>(args)...);
+        resize(newCapacity);
+        T* element{m_Data + m_Size};
+        AllocatorTraits::construct(m_Allocator, element, value);
+        ++m_Size;
+        return *element;
+    }
+
+    T* newData{allocate(newCapacity)};
+    T* element{nullptr};
+    try
+    {
+        AllocatorTraits::construct(m_Allocator, newData + m_Size,
+                                   std::forward<Args>(args)...);
+        element = newData + m_Size;
+        relocate(begin(), end(), newData);
+    }
+    catch (...)
+    {
+        if (element != nullptr)
+        {
+            AllocatorTraits::destroy(m_Allocator, element);
+        }
+        deallocate(newData, newCapacity);
+        throw;
+    }
+    release();
+    m_Data = newData;
+    m_Capacity = newCapacity;
+    ++m_Size;
+    return *element;
+}
+
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+void DynamicArray<T, Allocator>::insert(size_type index, ForwardIt first,
+                                        ForwardIt last)
+{
+    if (index > m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    size_type oldSize{m_Size};
+    append(first, last);
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+template <typename T, typename Allocator>
+template <typename ForwardIt>
+void DynamicArray<T, Allocator>::append(ForwardIt first, ForwardIt last)
+{
+    auto n{static_cast<size_type>(std::distance(first, last))};
+    grow(m_Size + n);
+    construct(first, last, end());
+    m_Size += n;
 }
 
-template <typename T>
-void DynamicArray<T>::remove(size_type index)
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::remove(size_type index)
 {
     if (index >= m_Size)
         throw std::out_of_range("Index out of range!");
 
+    std::move(begin() + index + 1, end(), begin() + index);
     --m_Size;
-    while (index < m_Size)
+    AllocatorTraits::destroy(m_Allocator, m_Data + m_Size);
+    shrink();
+}
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::remove(size_type first, size_type last)
+{
+    if (first > last || last > m_Size)
+        throw std::out_of_range("Index out of range!");
+    if (first == last)
+        return;
+
+    destroy(std::move(begin() + last, end(), begin() + first), end());
+    m_Size -= last - first;
+    shrink();
+}
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::swapRemove(size_type index)
+{
+    if (index >= m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    if (index != m_Size - 1)
+    {
+        m_Data[index] = std::move(m_Data[m_Size - 1]);
+    }
+    --m_Size;
+    AllocatorTraits::destroy(m_Allocator, m_Data + m_Size);
+    shrink();
+}
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::reserve(size_type capacity)
+{
+    if (capacity > m_Capacity)
     {
-        m_Data[index] = m_Data[index + 1];
-        ++index;
+        resize(capacity);
     }
-    if (m_Size < (m_Capacity / 2))
+}
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::shrinkToFit()
+{
+    if (m_Size < m_Capacity)
     {
-        resize(m_Capacity / 2);
+        resize(m_Size);
     }
 }
 
-template <typename T>
-T& DynamicArray<T>::get(size_type index)
+template <typename T, typename Allocator>
+T& DynamicArray<T, Allocator>::get(size_type index)
 {
     return const_cast<T&>(const_cast<const DynamicArray*>(this)->get(index));
 }
 
-template <typename T>
-const T& DynamicArray<T>::get(size_type index) const
+template <typename T, typename Allocator>
+const T& DynamicArray<T, Allocator>::get(size_type index) const
 {
     if (index >= m_Size)
         throw std::out_of_range("Index out of range!");
@@ -282,14 +760,66 @@ const T& DynamicArray<T>::get(size_type index) const
     return m_Data[index];
 }
 
-template <typename T>
-void DynamicArray<T>::resize(size_type newCapacity)
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::resize(size_type newCapacity)
 {
-    std::unique_ptr<T[]> newData = std::make_unique<T[]>(newCapacity);
-
-    std::copy(begin(), end(), newData.get());
+    if constexpr (REALLOCATABLE)
+    {
+        // `realloc` to zero bytes may or may not free the block.
+        if (newCapacity == 0)
+        {
+            std::free(m_Data);
+            m_Data = nullptr;
+            m_Capacity = 0;
+            return;
+        }
+        void* data{std::realloc(
+            m_Data, static_cast<std::size_t>(newCapacity) * sizeof(T))};
+        if (data == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        m_Data = static_cast<T*>(data);
+        m_Capacity = newCapacity;
+        return;
+    }
 
-    // Assigning to unique_ptr should free it's previous resource
-    m_Data = std::move(newData);
+    T* newData{allocate(newCapacity)};
+    try
+    {
+        relocate(begin(), end(), newData);
+    }
+    catch (...)
+    {
+        deallocate(newData, newCapacity);
+        throw;
+    }
+    release();
+    m_Data = newData;
     m_Capacity = newCapacity;
 }
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::grow(size_type n)
+{
+    if (n > m_Capacity)
+    {
+        resize(std::max(n, m_Capacity * 2));
+    }
+}
+
+template <typename T, typename Allocator>
+void DynamicArray<T, Allocator>::shrink()
+{
+    // Halving only below a quarter leaves the array half full, so as many
+    // inserts as removes are needed before capacity changes again.
+    size_type newCapacity{m_Capacity};
+    while (newCapacity > 2 && m_Size < newCapacity / 4)
+    {
+        newCapacity /= 2;
+    }
+    if (newCapacity != m_Capacity)
+    {
+        resize(newCapacity);
+    }
+}
@@ -41,8 +41,9 @@
  * @endcode
  *
  * @tparam T Type of the stored values.
+ * @tparam Allocator Allocator of the underlying DynamicArray.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Heap
 {
   public:
@@ -50,7 +51,7 @@ class Heap
      * @brief Type used for indexing and size definition.
      *
      */
-    typedef typename DynamicArray<T>::size_type size_type;
+    typedef typename DynamicArray<T, Allocator>::size_type size_type;
 
     /**
      * @brief Construct a new Heap object.
@@ -58,15 +59,27 @@ class Heap
      */
     Heap() = default;
 
+    /**
+     * @brief Construct a new Heap object that allocates with the given
+     * allocator.
+     *
+     * @param allocator Allocator of the underlying DynamicArray.
+     */
+    explicit Heap(const Allocator& allocator) : m_Data(allocator)
+    {
+    }
+
     /**
      * @brief Construct a new Heap object with custom compare function.
      *
      * @details Can be used to create max heap or custom implementations.
      *
      * @param compare Compare function.
+     * @param allocator Allocator of the underlying DynamicArray.
      */
-    explicit Heap(std::function<bool(const T& a, const T& b)> compare)
-        : m_Cmp{compare} {};
+    explicit Heap(std::function<bool(const T& a, const T& b)> compare,
+                  const Allocator& allocator = Allocator())
+        : m_Data(allocator), m_Cmp{compare} {};
 
     /**
      * @brief Destroy the Heap object.
@@ -116,7 +129,7 @@ class Heap
     }
 
   private:
-    DynamicArray<T> m_Data;
+    DynamicArray<T, Allocator> m_Data;
 
     const std::function<bool(const T& a, const T& b)> m_Cmp{
         [](const T& a, const T& b) { return a < b; }};
@@ -138,8 +151,8 @@ class Heap
     void heapify(size_type index);
 };
 
-template <typename T>
-void Heap<T>::insert(const T& item)
+template <typename T, typename Allocator>
+void Heap<T, Allocator>::insert(const T& item)
 {
     m_Data.insert(item);
     size_type idx{m_Data.size() - 1};
@@ -151,8 +164,8 @@ void Heap<T>::insert(const T& item)
     }
 }
 
-template <typename T>
-void Heap<T>::pop()
+template <typename T, typename Allocator>
+void Heap<T, Allocator>::pop()
 {
     if (empty())
     {
@@ -165,8 +178,8 @@ void Heap<T>::pop()
     heapify(0);
 }
 
-template <typename T>
-T& Heap<T>::peek()
+template <typename T, typename Allocator>
+T& Heap<T, Allocator>::peek()
 {
     if (empty())
     {
@@ -175,16 +188,16 @@ T& Heap<T>::peek()
     return m_Data[0];
 }
 
-template <typename T>
-void Heap<T>::swap(T* first, T* second)
+template <typename T, typename Allocator>
+void Heap<T, Allocator>::swap(T* first, T* second)
 {
     T tmp = *first;
     *first = *second;
     *second = tmp;
 }
 
-template <typename T>
-void Heap<T>::heapify(size_type index)
+template <typename T, typename Allocator>
+void Heap<T, Allocator>::heapify(size_type index)
 {
     size_type leftChildIdx{getLeftChild(index)};
     size_type rightChildIdx{getRightChild(index)};
@@ -0,0 +1,631 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Template for dynamic array container class with inline storage for
+ * a few elements.
+ *
+ * @details Same interface as `DynamicArray`, but up to `N` elements are
+ * stored inside the object itself, so arrays that stay that small never
+ * allocate. Larger arrays spill to the heap and come back into the object
+ * when removals leave them small enough, with the same capacity policy as
+ * `DynamicArray`: capacity doubles when the array is full and halves when it
+ * is less than a quarter full.
+ *
+ * Moving an array whose elements are stored inline moves the elements one by
+ * one, so moves and swaps are `O(N)` instead of `O(1)`. Pick `N` for the
+ * sizes most arrays actually have, the object is at least
+ * `N * sizeof(T)` bytes large.
+ *
+ *
+ * Example usage:
+ * @code
+ * SmallDynamicArray<int, 8> smallArray;
+ * smallArray.insert(1);
+ * int b{smallArray[0]};
+ * @endcode
+ *
+ *
+ * @tparam T Type of the stored values.
+ * @tparam N Number of elements stored without allocating.
+ */
+template <typename T, uint32_t N>
+class SmallDynamicArray
+{
+    static_assert(N > 0, "Inline capacity must not be zero!");
+
+  public:
+    /**
+     * @brief Type used for indexing and size definition.
+     *
+     */
+    using size_type = uint32_t;
+
+    /**
+     * @brief Construct a new SmallDynamicArray object.
+     *
+     */
+    SmallDynamicArray() : m_Size{0}, m_Capacity{N}, m_Data{inlineData()}
+    {
+    }
+
+    /**
+     * @brief Construct a new SmallDynamicArray object from initializer list.
+     *
+     * @param list Initializer list.
+     */
+    SmallDynamicArray(std::initializer_list<T> list) : SmallDynamicArray()
+    {
+        // The delegated constructor has finished, so the destructor cleans
+        // up if a copy throws.
+        append(list.begin(), list.end());
+    }
+
+    SmallDynamicArray(const SmallDynamicArray<T, N>& array)
+        : SmallDynamicArray()
+    {
+        append(array.begin(), array.end());
+    }
+
+    SmallDynamicArray<T, N>& operator=(const SmallDynamicArray<T, N>& array)
+    {
+        if (this != &array)
+        {
+            *this = SmallDynamicArray<T, N>(array);
+        }
+        return *this;
+    }
+
+    SmallDynamicArray(SmallDynamicArray<T, N>&& array) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        : SmallDynamicArray()
+    {
+        take(array);
+    }
+
+    /**
+     * @brief Destroy the SmallDynamicArray object.
+     *
+     */
+    ~SmallDynamicArray()
+    {
+        release();
+    }
+
+    SmallDynamicArray<T, N>& operator=(
+        SmallDynamicArray<T, N>&& array) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &array)
+        {
+            release();
+            m_Size = 0;
+            m_Capacity = N;
+            m_Data = inlineData();
+            take(array);
+        }
+        return *this;
+    }
+
+    bool operator==(const SmallDynamicArray<T, N>& other) const
+    {
+        return m_Size == other.m_Size &&
+               std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const SmallDynamicArray<T, N>& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Return pointer to first element, for range loop.
+     *
+     * @return T* Pointer to the first element.
+     */
+    T* begin()
+    {
+        return m_Data;
+    }
+
+    const T* begin() const
+    {
+        return m_Data;
+    }
+
+    /**
+     * @brief Return pointer to one past last element, for range loop.
+     *
+     * @return T* Pointer to one past last element.
+     */
+    T* end()
+    {
+        return m_Data + m_Size;
+    }
+
+    const T* end() const
+    {
+        return m_Data + m_Size;
+    }
+
+    /**
+     * @brief Inserts element to the array.
+     *
+     * @details Moves the elements to the heap if the array is full.
+     *
+     * @param element The element to be copied into the array.
+     */
+    void insert(const T& element)
+    {
+        emplace(element);
+    }
+
+    /**
+     * @brief Inserts element to the array.
+     *
+     * @details Same as `insert(const T&)`, the element is moved from.
+     *
+     * @param element The element to be moved into the array.
+     */
+    void insert(T&& element)
+    {
+        emplace(std::move(element));
+    }
+
+    /**
+     * @brief Construct an element in place at the end of the array.
+     *
+     * @details Arguments may refer to elements of the array, the new element
+     * is constructed before the others are relocated.
+     *
+     * @tparam Args Types of the constructor arguments.
+     * @param args Arguments forwarded to the constructor of `T`.
+     *
+     * @return `T&` Reference to the new element.
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
+    /**
+     * @brief Insert copies of a range of elements before an index.
+     *
+     * @details Allocates at most once. The range must not point into the
+     * array.
+     *
+     * @tparam ForwardIt Forward iterator type.
+     * @param index Index the first inserted element gets, up to `size()`.
+     * @param first Iterator to the first element to insert.
+     * @param last Iterator to one past the last element to insert.
+     */
+    template <typename ForwardIt>
+    void insert(size_type index, ForwardIt first, ForwardIt last);
+
+    /**
+     * @brief Insert copies of a range of elements at the end of the array.
+     *
+     * @details Allocates at most once. The range must not point into the
+     * array.
+     *
+     * @tparam ForwardIt Forward iterator type.
+     * @param first Iterator to the first element to insert.
+     * @param last Iterator to one past the last element to insert.
+     */
+    template <typename ForwardIt>
+    void append(ForwardIt first, ForwardIt last);
+
+    /**
+     * @brief Remove element at an index from the array.
+     *
+     * @details Reduces heap capacity if the container becomes less than a
+     * quarter full, down to the inline storage.
+     *
+     * @param index Index of the element to remove.
+     */
+    void remove(size_type index);
+
+    /**
+     * @brief Remove the elements in the index range `[first, last)`.
+     *
+     * @param first Index of the first element to remove.
+     * @param last Index of one past the last element to remove.
+     */
+    void remove(size_type first, size_type last);
+
+    /**
+     * @brief Remove element at an index by moving the last element into its
+     * place.
+     *
+     * @details Works in `O(1)` but does not keep the order of the elements.
+     *
+     * @param index Index of the element to remove.
+     */
+    void swapRemove(size_type index);
+
+    /**
+     * @brief Grow capacity to at least the given number of elements.
+     *
+     * @param capacity Number of elements to allocate storage for.
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * @brief Reduce capacity to the number of elements, moving them back
+     * into the inline storage if they fit.
+     *
+     */
+    void shrinkToFit();
+
+    /**
+     * @brief Access element at given index.
+     *
+     * @param index Index of the element to access.
+     *
+     * @return `T&` Reference to stored value.
+     */
+    T& operator[](size_type index)
+    {
+        return get(index);
+    }
+
+    /**
+     * @brief Access element at given index.
+     *
+     * @param index Index of the element to access.
+     *
+     * @return `const T&` Const reference to stored value.
+     */
+    const T& operator[](size_type index) const
+    {
+        return get(index);
+    }
+
+    /**
+     * @brief Access element at given index.
+     *
+     * @param index Index of the element to access.
+     *
+     * @return `T&` Reference to stored value.
+     */
+    T& get(size_type index);
+
+    /**
+     * @brief Access element at given index.
+     *
+     * @param index Index of the element to access.
+     *
+     * @return `const T&` Const reference to stored value.
+     */
+    const T& get(size_type index) const;
+
+    /**
+     * @brief Get number of items in the container.
+     *
+     * @return `size_type` Number of stored items.
+     */
+    size_type size() const
+    {
+        return m_Size;
+    }
+
+    /**
+     * @brief Get capacity of the container, at least `N`.
+     *
+     * @return `size_type` Capacity of the container.
+     */
+    size_type capacity() const
+    {
+        return m_Capacity;
+    }
+
+    /**
+     * @brief Check if the array is empty.
+     *
+     * @return `true` If the array is empty.
+     * @return `false` If the array contains any elements.
+     */
+    bool empty() const
+    {
+        return m_Size == 0;
+    }
+
+    /**
+     * @brief Check if the elements are stored inside the object.
+     *
+     * @return `true` If the elements are stored inline.
+     * @return `false` If the elements are stored on the heap.
+     */
+    bool isInline() const
+    {
+        return m_Data == inlineData();
+    }
+
+  private:
+    size_type m_Size;
+    size_type m_Capacity;
+    T* m_Data;
+    alignas(T) unsigned char m_Buffer[N * sizeof(T)];
+
+    T* inlineData()
+    {
+        return reinterpret_cast<T*>(m_Buffer);
+    }
+
+    const T* inlineData() const
+    {
+        return reinterpret_cast<const T*>(m_Buffer);
+    }
+
+    /**
+     * @brief Move or copy elements into uninitialized storage.
+     *
+     * @details Moves if that cannot throw or `T` cannot be copied, like
+     * `std::move_if_noexcept`.
+     */
+    static void relocate(T* first, T* last, T* destination)
+    {
+        if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                      !std::is_copy_constructible_v<T>)
+        {
+            std::uninitialized_move(first, last, destination);
+        }
+        else
+        {
+            std::uninitialized_copy(first, last, destination);
+        }
+    }
+
+    void release() noexcept
+    {
+        std::destroy(begin(), end());
+        if (!isInline())
+        {
+            std::allocator<T>{}.deallocate(m_Data, m_Capacity);
+        }
+    }
+
+    /**
+     * @brief Take the elements of another array into an empty inline one,
+     * leaving the other array empty.
+     *
+     */
+    void take(SmallDynamicArray<T, N>& array);
+
+    void resize(size_type newCapacity);
+
+    /**
+     * @brief Make room for at least `n` elements, at least doubling capacity
+     * if it grows.
+     *
+     */
+    void grow(size_type n);
+
+    /**
+     * @brief Halve heap capacity until the array is at least a quarter full
+     * or fits into the inline storage.
+     *
+     */
+    void shrink();
+};
+
+template <typename T, uint32_t N>
+template <typename... Args>
+T& SmallDynamicArray<T, N>::emplace(Args&&... args)
+{
+    if (m_Size < m_Capacity)
+    {
+        T* element{::new (static_cast<void*>(m_Data + m_Size))
+                       T(std::forward<Args>(args)...)};
+        ++m_Size;
+        return *element;
+    }
+
+    size_type newCapacity{m_Capacity * 2};
+    T* newData{std::allocator<T>{}.allocate(newCapacity)};
+    T* element{nullptr};
+    try
+    {
+        element = ::new (static_cast<void*>(newData + m_Size))
+            T(std::forward<Args>(args)...);
+        relocate(begin(), end(), newData);
+    }
+    catch (...)
+    {
+        if (element != nullptr)
+        {
+            std::destroy_at(element);
+        }
+        std::allocator<T>{}.deallocate(newData, newCapacity);
+        throw;
+    }
+    release();
+    m_Data = newData;
+    m_Capacity = newCapacity;
+    ++m_Size;
+    return *element;
+}
+
+template <typename T, uint32_t N>
+template <typename ForwardIt>
+void SmallDynamicArray<T, N>::insert(size_type index, ForwardIt first,
+                                     ForwardIt last)
+{
+    if (index > m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    size_type oldSize{m_Size};
+    append(first, last);
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+template <typename T, uint32_t N>
+template <typename ForwardIt>
+void SmallDynamicArray<T, N>::append(ForwardIt first, ForwardIt last)
+{
+    auto n{static_cast<size_type>(std::distance(first, last))};
+    grow(m_Size + n);
+    std::uninitialized_copy(first, last, end());
+    m_Size += n;
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::remove(size_type index)
+{
+    if (index >= m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    std::move(begin() + index + 1, end(), begin() + index);
+    --m_Size;
+    std::destroy_at(m_Data + m_Size);
+    shrink();
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::remove(size_type first, size_type last)
+{
+    if (first > last || last > m_Size)
+        throw std::out_of_range("Index out of range!");
+    if (first == last)
+        return;
+
+    std::destroy(std::move(begin() + last, end(), begin() + first), end());
+    m_Size -= last - first;
+    shrink();
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::swapRemove(size_type index)
+{
+    if (index >= m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    if (index != m_Size - 1)
+    {
+        m_Data[index] = std::move(m_Data[m_Size - 1]);
+    }
+    --m_Size;
+    std::destroy_at(m_Data + m_Size);
+    shrink();
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::reserve(size_type capacity)
+{
+    if (capacity > m_Capacity)
+    {
+        resize(capacity);
+    }
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::shrinkToFit()
+{
+    size_type newCapacity{std::max(m_Size, N)};
+    if (newCapacity < m_Capacity)
+    {
+        resize(newCapacity);
+    }
+}
+
+template <typename T, uint32_t N>
+T& SmallDynamicArray<T, N>::get(size_type index)
+{
+    return const_cast<T&>(
+        const_cast<const SmallDynamicArray*>(this)->get(index));
+}
+
+template <typename T, uint32_t N>
+const T& SmallDynamicArray<T, N>::get(size_type index) const
+{
+    if (index >= m_Size)
+        throw std::out_of_range("Index out of range!");
+
+    return m_Data[index];
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::take(SmallDynamicArray<T, N>& array)
+{
+    if (!array.isInline())
+    {
+        m_Size = std::exchange(array.m_Size, 0);
+        m_Capacity = std::exchange(array.m_Capacity, N);
+        m_Data = std::exchange(array.m_Data, array.inlineData());
+        return;
+    }
+
+    std::uninitialized_move(array.begin(), array.end(), m_Data);
+    m_Size = array.m_Size;
+    std::destroy(array.begin(), array.end());
+    array.m_Size = 0;
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::resize(size_type newCapacity)
+{
+    // Capacities up to `N` are the inline storage.
+    if (newCapacity <= N)
+    {
+        if (isInline())
+        {
+            return;
+        }
+        relocate(begin(), end(), inlineData());
+        T* oldData{m_Data};
+        size_type oldCapacity{m_Capacity};
+        std::destroy(begin(), end());
+        m_Data = inlineData();
+        m_Capacity = N;
+        std::allocator<T>{}.deallocate(oldData, oldCapacity);
+        return;
+    }
+
+    T* newData{std::allocator<T>{}.allocate(newCapacity)};
+    try
+    {
+        relocate(begin(), end(), newData);
+    }
+    catch (...)
+    {
+        std::allocator<T>{}.deallocate(newData, newCapacity);
+        throw;
+    }
+    release();
+    m_Data = newData;
+    m_Capacity = newCapacity;
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::grow(size_type n)
+{
+    if (n > m_Capacity)
+    {
+        resize(std::max(n, m_Capacity * 2));
+    }
+}
+
+template <typename T, uint32_t N>
+void SmallDynamicArray<T, N>::shrink()
+{
+    if (isInline())
+    {
+        return;
+    }
+    size_type newCapacity{m_Capacity};
+    while (newCapacity > N && m_Size < newCapacity / 4)
+    {
+        newCapacity = std::max(N, newCapacity / 2);
+    }
+    if (newCapacity != m_Capacity)
+    {
+        resize(newCapacity);
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "DataStructures/DynamicArray.hpp"
 
+#include <memory>
 #include <stdexcept>
 
 /**
@@ -22,8 +23,9 @@
  * @endcode
  *
  * @tparam T Type of the stored values.
+ * @tparam Allocator Allocator of the underlying DynamicArray.
  */
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class Stack
 {
   public:
@@ -31,7 +33,7 @@ class Stack
      * @brief Type used for indexing and size definition.
      *
      */
-    typedef typename DynamicArray<T>::size_type size_type;
+    typedef typename DynamicArray<T, Allocator>::size_type size_type;
 
     /**
      * @brief Construct a new Stack object.
@@ -39,6 +41,16 @@ class Stack
      */
     Stack() = default;
 
+    /**
+     * @brief Construct a new Stack object that allocates with the given
+     * allocator.
+     *
+     * @param allocator Allocator of the underlying DynamicArray.
+     */
+    explicit Stack(const Allocator& allocator) : m_Data(allocator)
+    {
+    }
+
     /**
      * @brief Destroy the Stack object.
      *
@@ -87,17 +99,17 @@ class Stack
     }
 
   private:
-    DynamicArray<T> m_Data;
+    DynamicArray<T, Allocator> m_Data;
 };
 
-template <typename T>
-void Stack<T>::insert(const T& item)
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::insert(const T& item)
 {
     m_Data.insert(item);
 }
 
-template <typename T>
-void Stack<T>::pop()
+template <typename T, typename Allocator>
+void Stack<T, Allocator>::pop()
 {
     if (empty())
     {
@@ -106,8 +118,8 @@ void Stack<T>::pop()
     m_Data.remove(size() - 1);
 }
 
-template <typename T>
-T& Stack<T>::peek()
+template <typename T, typename Allocator>
+T& Stack<T, Allocator>::peek()
 {
     if (empty())
     {
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Algorithms/AdaptiveSort.hpp"
+
+std::vector<int> getRandomKeys(int n, int mask)
+{
+    std::mt19937 g(static_cast<unsigned>(n));
+    std::vector<int> keys(n);
+    for (int& x : keys)
+    {
+        x = static_cast<int>(g()) & mask;
+    }
+    return keys;
+}
+
+std::vector<int> getAscending(int n)
+{
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), -n / 2);
+    return keys;
+}
+
+TEST(AdaptiveSortTest, SortsEveryDistribution)
+{
+    for (int n : {0, 1, 2, 31, 32, 33, 100, 1000, 5000, 100000})
+    {
+        std::vector<int> ascending{getAscending(n)};
+        std::vector<int> descending(ascending.rbegin(), ascending.rend());
+        std::vector<int> sawtooth(n);
+        for (int i{0}; i < n; ++i)
+        {
+            sawtooth[i] = i % 1000;
+        }
+        for (std::vector<int> keys :
+             {getRandomKeys(n, -1), getRandomKeys(n, 15),
+              getRandomKeys(n, 0xffff), ascending, descending, sawtooth})
+        {
+            std::vector<int> expected{keys};
+            std::sort(expected.begin(), expected.end());
+
+            sort::sort(keys.begin(), keys.end());
+
+            ASSERT_EQ(keys, expected);
+        }
+    }
+}
+
+TEST(AdaptiveSortTest, InsertionForTinyRanges)
+{
+    std::vector<int> keys{getRandomKeys(20, -1)};
+    sort::SortDecision decision;
+
+    sort::sort(keys.begin(), keys.end(), std::less<>{}, decision);
+
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    ASSERT_EQ(decision.path, sort::SortPath::Insertion);
+    ASSERT_EQ(decision.size, 20U);
+}
+
+TEST(AdaptiveSortTest, MergeForPresortedInput)
+{
+    int n{100000};
+    std::vector<int> ascending{getAscending(n)};
+    std::vector<int> descending(ascending.rbegin(), ascending.rend());
+    std::vector<int> nearlySorted{ascending};
+    std::mt19937 g(1);
+    std::uniform_int_distribution<int> index(0, n - 1);
+    for (int i{0}; i < n / 1000; ++i)
+    {
+        std::swap(nearlySorted[index(g)], nearlySorted[index(g)]);
+    }
+
+    for (std::vector<int> keys : {ascending, descending, nearlySorted})
+    {
+        sort::SortDecision decision;
+
+        sort::sort(keys.begin(), keys.end(), std::less<>{}, decision);
+
+        ASSERT_EQ(keys, ascending);
+        ASSERT_EQ(decision.path, sort::SortPath::Merge);
+    }
+}
+
+TEST(AdaptiveSortTest, RadixForLargeRangesOfKeys)
+{
+    sort::SortDecision decision;
+
+    std::vector<int> keys{getRandomKeys(100000, -1)};
+    sort::sort(keys.begin(), keys.end(), std::less<>{}, decision);
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    ASSERT_EQ(decision.path, sort::SortPath::Radix);
+    ASSERT_EQ(decision.keyBytes, 4U);
+
+    // Keys that differ in fewer bytes need fewer radix passes.
+    std::vector<int> narrow{getRandomKeys(600, 0xffff)};
+    sort::sort(narrow.begin(), narrow.end(), std::less<>{}, decision);
+    ASSERT_EQ(decision.path, sort::SortPath::Radix);
+    ASSERT_EQ(decision.keyBytes, 2U);
+
+    std::vector<int> wide{getRandomKeys(600, -1)};
+    sort::sort(wide.begin(), wide.end(), std::less<>{}, decision);
+    ASSERT_EQ(decision.path, sort::SortPath::Intro);
+    ASSERT_EQ(decision.keyBytes, 4U);
+
+    std::vector<int> small{getRandomKeys(200, 0xff)};
+    sort::sort(small.begin(), small.end(), std::less<>{}, decision);
+    ASSERT_EQ(decision.path, sort::SortPath::Intro);
+    ASSERT_EQ(decision.keyBytes, 0U);
+
+    std::vector<double> doubles(100000);
+    std::mt19937 g(2);
+    std::normal_distribution<double> normal;
+    for (double& x : doubles)
+    {
+        x = normal(g);
+    }
+    sort::sort(doubles.begin(), doubles.end(), std::less<double>{},
+               decision);
+    ASSERT_TRUE(std::is_sorted(doubles.begin(), doubles.end()));
+    ASSERT_EQ(decision.path, sort::SortPath::Radix);
+}
+
+TEST(AdaptiveSortTest, DuplicatesFavourIntroSort)
+{
+    sort::SortDecision decision;
+
+    // Sixteen distinct keys spread over all four bytes.
+    std::vector<int> pool{getRandomKeys(16, -1)};
+    std::vector<int> fewUnique{getRandomKeys(100000, 15)};
+    for (int& x : fewUnique)
+    {
+        x = pool[x];
+    }
+    sort::sort(fewUnique.begin(), fewUnique.end(), std::less<>{}, decision);
+    ASSERT_TRUE(std::is_sorted(fewUnique.begin(), fewUnique.end()));
+    ASSERT_EQ(decision.path, sort::SortPath::Intro);
+    ASSERT_GE(decision.duplicates, 0.5);
+    ASSERT_EQ(decision.keyBytes, 4U);
+
+    // Duplicates within a single byte take a single radix pass.
+    std::vector<int> narrow{getRandomKeys(100000, 15)};
+    sort::sort(narrow.begin(), narrow.end(), std::less<>{}, decision);
+    ASSERT_TRUE(std::is_sorted(narrow.begin(), narrow.end()));
+    ASSERT_EQ(decision.path, sort::SortPath::Radix);
+    ASSERT_EQ(decision.keyBytes, 1U);
+}
+
+TEST(AdaptiveSortTest, ComparatorsOtherThanLessNeverUseRadix)
+{
+    sort::SortDecision decision;
+
+    std::vector<int> keys{getRandomKeys(100000, -1)};
+    sort::sort(keys.begin(), keys.end(), std::greater<>{}, decision);
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end(), std::greater<>{}));
+    ASSERT_EQ(decision.path, sort::SortPath::Intro);
+    ASSERT_EQ(decision.keyBytes, 0U);
+
+    std::vector<std::string> words;
+    for (int key : getRandomKeys(5000, 0xfffff))
+    {
+        words.push_back(std::to_string(key));
+    }
+    std::vector<std::string> expected{words};
+    std::sort(expected.begin(), expected.end());
+    sort::sort(words.begin(), words.end(), std::less<>{}, decision);
+    ASSERT_EQ(words, expected);
+    ASSERT_EQ(decision.path, sort::SortPath::Intro);
+}
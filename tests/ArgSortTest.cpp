@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Algorithms/ArgSort.hpp"
+
+template <typename T>
+std::vector<T> getRandomKeys(int n, int maxKey)
+{
+    std::mt19937 g(11);
+    std::uniform_int_distribution<int> keys(-maxKey, maxKey);
+    std::vector<T> result(n);
+    for (T& x : result)
+    {
+        x = static_cast<T>(keys(g));
+    }
+    return result;
+}
+
+template <typename T, typename Compare = std::less<>>
+std::vector<std::size_t> getStableOrder(const std::vector<T>& keys,
+                                        Compare comp = Compare{})
+{
+    std::vector<std::size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) {
+                         return comp(keys[a], keys[b]);
+                     });
+    return order;
+}
+
+TEST(ArgSortTest, ArgSortIntegerKeys)
+{
+    std::vector<int> keys{getRandomKeys<int>(10000, 100)};
+    std::vector<int> original{keys};
+
+    std::vector<std::size_t> order{sort::argSort(keys.begin(), keys.end())};
+
+    ASSERT_EQ(keys, original);
+    ASSERT_EQ(order, getStableOrder(keys));
+}
+
+TEST(ArgSortTest, ArgSortWideAndNarrowIntegers)
+{
+    std::vector<int64_t> wide{getRandomKeys<int64_t>(5000, 1000)};
+    for (int64_t& x : wide)
+    {
+        x *= int64_t{1} << 40;
+    }
+    std::vector<uint8_t> narrow{getRandomKeys<uint8_t>(5000, 100)};
+
+    ASSERT_EQ(sort::argSort(wide.begin(), wide.end()), getStableOrder(wide));
+    ASSERT_EQ(sort::argSort(narrow.begin(), narrow.end()),
+              getStableOrder(narrow));
+}
+
+TEST(ArgSortTest, ArgSortFloatingPointKeys)
+{
+    std::vector<float> scores;
+    for (int x : getRandomKeys<int>(10000, 300))
+    {
+        scores.push_back(x * 0.25f);
+    }
+
+    std::vector<std::size_t> order{
+        sort::argSort(scores.begin(), scores.end())};
+
+    ASSERT_EQ(order, getStableOrder(scores));
+}
+
+TEST(ArgSortTest, ArgSortWithComparatorIsStable)
+{
+    std::vector<double> keys;
+    for (int x : getRandomKeys<int>(10000, 50))
+    {
+        keys.push_back(x / 2.0);
+    }
+
+    std::vector<std::size_t> order{
+        sort::argSort(keys.begin(), keys.end(), std::greater<>{})};
+
+    ASSERT_EQ(order, getStableOrder(keys, std::greater<>{}));
+}
+
+TEST(ArgSortTest, ArgSortStrings)
+{
+    std::vector<std::string> keys{"pear", "apple", "fig", "apple", "kiwi"};
+
+    std::vector<std::size_t> order{sort::argSort(keys.begin(), keys.end())};
+
+    ASSERT_EQ(order, (std::vector<std::size_t>{1, 3, 2, 4, 0}));
+}
+
+TEST(ArgSortTest, ArgSortEmptyRange)
+{
+    std::vector<int> keys;
+
+    ASSERT_TRUE(sort::argSort(keys.begin(), keys.end()).empty());
+}
+
+TEST(ArgSortTest, PermuteReordersRange)
+{
+    std::vector<std::string> values{"a", "b", "c", "d"};
+
+    sort::permute(values.begin(), {2, 0, 3, 1});
+
+    ASSERT_EQ(values, (std::vector<std::string>{"c", "a", "d", "b"}));
+}
+
+TEST(ArgSortTest, SortByKeyPermutesPayloads)
+{
+    int n{10000};
+    std::vector<int64_t> keys{getRandomKeys<int64_t>(n, 500)};
+    std::vector<uint32_t> rowIds(n);
+    std::iota(rowIds.begin(), rowIds.end(), 0u);
+    std::vector<double> values(n);
+    std::vector<std::string> labels(n);
+    for (int i{0}; i < n; ++i)
+    {
+        values[i] = keys[i] * 0.5;
+        labels[i] = std::to_string(keys[i]);
+    }
+    std::vector<int64_t> original{keys};
+
+    sort::sortByKey(keys.begin(), keys.end(), rowIds.begin(), values.begin(),
+                    labels.begin());
+
+    ASSERT_TRUE(std::is_sorted(keys.begin(), keys.end()));
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(original[rowIds[i]], keys[i]);
+        ASSERT_EQ(values[i], keys[i] * 0.5);
+        ASSERT_EQ(labels[i], std::to_string(keys[i]));
+        if (i > 0 && keys[i - 1] == keys[i])
+        {
+            ASSERT_LT(rowIds[i - 1], rowIds[i]);
+        }
+    }
+}
+
+TEST(ArgSortTest, SortByKeyWithoutPayload)
+{
+    std::vector<int> keys{getRandomKeys<int>(1000, 1000)};
+    std::vector<int> expected{keys};
+    std::sort(expected.begin(), expected.end());
+
+    sort::sortByKey(keys.begin(), keys.end());
+
+    ASSERT_EQ(keys, expected);
+}
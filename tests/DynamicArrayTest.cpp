@@ -1,18 +1,126 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "DataStructures/DynamicArray.hpp"
 
-template <typename T>
-bool compareToVector(const DynamicArray<T>& array, const std::vector<T>& vec)
+// Counts its copies and moves, copies throw once `throwOnCopy` is set.
+template <bool NoexceptMove>
+struct Tracked
 {
-    if (array.size() !=
-        static_cast<typename DynamicArray<T>::size_type>(vec.size()))
+    explicit Tracked(int v) : value{v}
+    {
+    }
+
+    Tracked(const Tracked& other) : value{other.value}
+    {
+        if (throwOnCopy)
+        {
+            throw std::runtime_error("Copy failed!");
+        }
+        ++copies;
+    }
+
+    Tracked(Tracked&& other) noexcept(NoexceptMove) : value{other.value}
+    {
+        ++moves;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&) = default;
+
+    int value;
+    static inline int copies{0};
+    static inline int moves{0};
+    static inline bool throwOnCopy{false};
+};
+
+// Counts the bytes allocated from it that are not deallocated yet.
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    std::size_t allocated{0};
+    std::size_t allocations{0};
+
+  private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocated += bytes;
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override
+    {
+        allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// Allocates storage aligned to `Alignment` bytes, like huge pages.
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    bool operator==(const AlignedAllocator&) const
+    {
+        return true;
+    }
+
+    bool operator!=(const AlignedAllocator&) const
+    {
         return false;
+    }
+};
 
-    for (typename DynamicArray<T>::size_type i{0}; i < array.size(); ++i)
+template <typename T, typename Allocator>
+bool compareToVector(const DynamicArray<T, Allocator>& array,
+                     const std::vector<T>& vec)
+{
+    using size_type = typename DynamicArray<T, Allocator>::size_type;
+    if (array.size() != static_cast<size_type>(vec.size()))
+        return false;
+
+    for (size_type i{0}; i < array.size(); ++i)
     {
         if (array[i] != vec[static_cast<typename std::vector<T>::size_type>(i)])
             return false;
@@ -214,9 +322,140 @@ TEST(DynamicArrayTest, DynamicResizeDown)
     ASSERT_GE(array.capacity(), n);
     for (int i{0}; i < n / 2 + 1; ++i)
         array.remove(1);
+    ASSERT_EQ(array.capacity(), 1024);
+    while (array.size() > 255)
+        array.remove(1);
     ASSERT_EQ(array.capacity(), 512);
 }
 
+TEST(DynamicArrayTest, InsertRemoveAtCapacityKeepsCapacity)
+{
+    DynamicArray<std::string> array;
+    for (int i{0}; i < 1025; ++i)
+        array.insert(std::to_string(i));
+    ASSERT_EQ(array.capacity(), 2048);
+    const std::string* data{array.begin()};
+    for (int i{0}; i < 100; ++i)
+    {
+        array.remove(array.size() - 1);
+        array.remove(array.size() - 1);
+        array.insert("x");
+        array.insert("y");
+    }
+    ASSERT_EQ(array.capacity(), 2048);
+    ASSERT_EQ(array.begin(), data);
+}
+
+TEST(DynamicArrayTest, ReserveAndShrinkToFit)
+{
+    DynamicArray<std::string> array;
+    array.reserve(100);
+    ASSERT_EQ(array.capacity(), 100);
+    const std::string* data{array.begin()};
+    for (int i{0}; i < 100; ++i)
+        array.insert(std::to_string(i));
+    ASSERT_EQ(array.begin(), data);
+    array.reserve(10);
+    ASSERT_EQ(array.capacity(), 100);
+
+    array.remove(50, 100);
+    ASSERT_EQ(array.capacity(), 100);
+    array.shrinkToFit();
+    ASSERT_EQ(array.capacity(), 50);
+    ASSERT_EQ(array[49], "49");
+
+    DynamicArray<int> numbers{1, 2, 3};
+    numbers.remove(0, 3);
+    numbers.shrinkToFit();
+    ASSERT_EQ(numbers.capacity(), 0);
+    ASSERT_TRUE(numbers.empty());
+    numbers.insert(4);
+    ASSERT_EQ(numbers[0], 4);
+}
+
+TEST(DynamicArrayTest, SwapRemove)
+{
+    DynamicArray<std::string> array{"a", "b", "c", "d"};
+    array.swapRemove(1);
+    ASSERT_TRUE(compareToVector(array, {"a", "d", "c"}));
+    array.swapRemove(2);
+    ASSERT_TRUE(compareToVector(array, {"a", "d"}));
+    array.swapRemove(0);
+    array.swapRemove(0);
+    ASSERT_TRUE(array.empty());
+    EXPECT_THROW(array.swapRemove(0), std::out_of_range);
+}
+
+TEST(DynamicArrayTest, RemoveRange)
+{
+    DynamicArray<std::string> array;
+    std::vector<std::string> vec;
+    for (int i{0}; i < 1000; ++i)
+    {
+        array.insert(std::to_string(i));
+        vec.push_back(std::to_string(i));
+    }
+    array.remove(10, 20);
+    vec.erase(vec.begin() + 10, vec.begin() + 20);
+    ASSERT_TRUE(compareToVector(array, vec));
+    array.remove(5, 5);
+    ASSERT_TRUE(compareToVector(array, vec));
+
+    // Removing most elements at once shrinks by more than half.
+    array.remove(0, 980);
+    vec.erase(vec.begin(), vec.begin() + 980);
+    ASSERT_TRUE(compareToVector(array, vec));
+    ASSERT_EQ(array.capacity(), 32);
+
+    EXPECT_THROW(array.remove(3, 2), std::out_of_range);
+    EXPECT_THROW(array.remove(0, 11), std::out_of_range);
+}
+
+TEST(DynamicArrayTest, InsertAndAppendRange)
+{
+    DynamicArray<std::string> array{"a", "e"};
+    std::vector<std::string> middle{"b", "c", "d"};
+    array.insert(1, middle.begin(), middle.end());
+    ASSERT_TRUE(compareToVector(array, {"a", "b", "c", "d", "e"}));
+    array.insert(0, middle.begin(), middle.begin() + 1);
+    array.insert(array.size(), middle.end() - 1, middle.end());
+    ASSERT_TRUE(
+        compareToVector(array, {"b", "a", "b", "c", "d", "e", "d"}));
+    EXPECT_THROW(array.insert(8, middle.begin(), middle.end()),
+                 std::out_of_range);
+
+    DynamicArray<std::string> moved;
+    moved.append(std::make_move_iterator(middle.begin()),
+                 std::make_move_iterator(middle.end()));
+    ASSERT_TRUE(compareToVector(moved, {"b", "c", "d"}));
+    ASSERT_TRUE(middle[0].empty());
+
+    DynamicArray<int> numbers;
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    numbers.append(values.begin(), values.end());
+    ASSERT_EQ(numbers.capacity(), 1000);
+    numbers.append(values.begin(), values.begin() + 1);
+    ASSERT_EQ(numbers.capacity(), 2000);
+    values.push_back(0);
+    ASSERT_TRUE(compareToVector(numbers, values));
+}
+
+TEST(DynamicArrayTest, AppendThrowingCopyKeepsElements)
+{
+    DynamicArray<Tracked<true>> array;
+    array.emplace(1);
+    std::vector<Tracked<true>> values;
+    values.emplace_back(2);
+    values.emplace_back(3);
+    Tracked<true>::throwOnCopy = true;
+    EXPECT_THROW(array.append(values.begin(), values.end()),
+                 std::runtime_error);
+    Tracked<true>::throwOnCopy = false;
+    ASSERT_EQ(array.size(), 1);
+    ASSERT_EQ(array[0].value, 1);
+}
+
 TEST(DynamicArrayTest, RemoveIncorrectIndex)
 {
     DynamicArray<int> array;
@@ -274,3 +513,285 @@ TEST(DynamicArrayTest, AccessIncorrectIndexOperator)
         },
         std::out_of_range);
 }
+
+TEST(DynamicArrayTest, InsertMovesElement)
+{
+    DynamicArray<std::string> array;
+    std::string text(100, 'x');
+    const char* buffer{text.data()};
+
+    array.insert(std::move(text));
+
+    // The string buffer was handed over, not copied.
+    ASSERT_EQ(array[0].data(), buffer);
+    ASSERT_EQ(array[0], std::string(100, 'x'));
+
+    std::string copied(100, 'y');
+    array.insert(copied);
+    ASSERT_EQ(copied, array[1]);
+}
+
+TEST(DynamicArrayTest, EmplaceConstructsInPlace)
+{
+    DynamicArray<std::pair<int, std::string>> array;
+    for (int i{0}; i < 100; ++i)
+    {
+        std::pair<int, std::string>& element{array.emplace(i, "e")};
+        ASSERT_EQ(element.first, i);
+    }
+    ASSERT_EQ(array.size(), 100);
+    ASSERT_EQ(array[42].first, 42);
+    ASSERT_EQ(array[42].second, "e");
+}
+
+TEST(DynamicArrayTest, MoveOnlyAndNotDefaultConstructible)
+{
+    DynamicArray<std::unique_ptr<int>> pointers;
+    for (int i{0}; i < 100; ++i)
+    {
+        pointers.insert(std::make_unique<int>(i));
+    }
+    pointers.remove(0);
+    ASSERT_EQ(pointers.size(), 99);
+    ASSERT_EQ(*pointers[0], 1);
+    ASSERT_EQ(*pointers[98], 99);
+
+    DynamicArray<Tracked<true>> tracked;
+    tracked.emplace(1);
+    tracked.emplace(2);
+    ASSERT_EQ(tracked[1].value, 2);
+}
+
+TEST(DynamicArrayTest, GrowthMovesNoexceptElements)
+{
+    Tracked<true>::copies = 0;
+    Tracked<true>::moves = 0;
+    DynamicArray<Tracked<true>> array;
+    for (int i{0}; i < 1000; ++i)
+    {
+        array.emplace(i);
+    }
+    ASSERT_EQ(Tracked<true>::copies, 0);
+    ASSERT_GT(Tracked<true>::moves, 0);
+    ASSERT_EQ(array[999].value, 999);
+}
+
+TEST(DynamicArrayTest, GrowthCopiesThrowingMoveElements)
+{
+    Tracked<false>::copies = 0;
+    Tracked<false>::moves = 0;
+    DynamicArray<Tracked<false>> array;
+    for (int i{0}; i < 1000; ++i)
+    {
+        array.emplace(i);
+    }
+    ASSERT_EQ(Tracked<false>::moves, 0);
+    ASSERT_GT(Tracked<false>::copies, 0);
+    ASSERT_EQ(array[999].value, 999);
+}
+
+TEST(DynamicArrayTest, ThrowingGrowthKeepsElements)
+{
+    DynamicArray<Tracked<false>> array;
+    array.emplace(1);
+    array.emplace(2);
+    ASSERT_EQ(array.size(), array.capacity());
+
+    Tracked<false>::throwOnCopy = true;
+    EXPECT_THROW(array.emplace(3), std::runtime_error);
+    Tracked<false>::throwOnCopy = false;
+
+    ASSERT_EQ(array.size(), 2);
+    ASSERT_EQ(array[0].value, 1);
+    ASSERT_EQ(array[1].value, 2);
+}
+
+TEST(DynamicArrayTest, InsertElementOfSameArray)
+{
+    DynamicArray<std::string> array;
+    array.insert(std::string(50, 'a'));
+    for (int i{0}; i < 100; ++i)
+    {
+        // Growth must not invalidate the argument before it is copied.
+        array.insert(array[0]);
+    }
+    for (const std::string& s : array)
+    {
+        ASSERT_EQ(s, std::string(50, 'a'));
+    }
+}
+
+TEST(DynamicArrayTest, InsertAfterMove)
+{
+    DynamicArray<std::string> array{"a", "b"};
+    DynamicArray<std::string> other{std::move(array)};
+
+    array.insert("c");
+    array.insert("d");
+    array.insert("e");
+
+    ASSERT_EQ(array.size(), 3);
+    ASSERT_EQ(array[2], "e");
+    ASSERT_EQ(other[1], "b");
+
+    other = array;
+    ASSERT_TRUE(other == array);
+    other.insert("f");
+    ASSERT_EQ(other.size(), 4);
+}
+
+TEST(DynamicArrayTest, TriviallyCopyableGrowAndShrink)
+{
+    DynamicArray<std::uint64_t> array;
+    int n{1 << 20};
+    for (int i{0}; i < n; ++i)
+    {
+        array.insert(static_cast<std::uint64_t>(i) << 32);
+        // Reallocation must not invalidate the argument.
+        array.insert(array[array.size() - 1] + 1);
+    }
+    ASSERT_EQ(array.size(), 2U * n);
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(array[2 * i], static_cast<std::uint64_t>(i) << 32);
+        ASSERT_EQ(array[2 * i + 1], (static_cast<std::uint64_t>(i) << 32) + 1);
+    }
+    while (array.size() > 3)
+    {
+        array.remove(array.size() - 1);
+    }
+    ASSERT_LE(array.capacity(), 8U);
+    ASSERT_EQ(array[2], std::uint64_t{1} << 32);
+}
+
+TEST(DynamicArrayTest, EqualityComparesValues)
+{
+    DynamicArray<double> zeros{0.0, 1.0};
+    DynamicArray<double> negativeZeros{-0.0, 1.0};
+    ASSERT_TRUE(zeros == negativeZeros);
+
+    struct Padded
+    {
+        char c;
+        int i;
+        bool operator!=(const Padded& other) const
+        {
+            return c != other.c || i != other.i;
+        }
+        bool operator==(const Padded& other) const
+        {
+            return !(*this != other);
+        }
+    };
+    Padded a;
+    Padded b;
+    std::memset(&a, 0x00, sizeof(a));
+    std::memset(&b, 0xff, sizeof(b));
+    a.c = b.c = 'x';
+    a.i = b.i = 7;
+    DynamicArray<Padded> first{a};
+    DynamicArray<Padded> second{b};
+    ASSERT_TRUE(first == second);
+
+    DynamicArray<int> empty;
+    DynamicArray<int> other{1};
+    other.remove(0);
+    ASSERT_TRUE(empty == other);
+}
+
+TEST(DynamicArrayTest, MemoryResourceAllocatesStorage)
+{
+    using Array = DynamicArray<int, std::pmr::polymorphic_allocator<int>>;
+    CountingResource resource;
+    {
+        Array array{&resource};
+        for (int i{0}; i < 1000; ++i)
+            array.insert(i);
+        ASSERT_EQ(resource.allocated, 1024 * sizeof(int));
+        ASSERT_EQ(array.getAllocator().resource(), &resource);
+        std::vector<int> vec(1000);
+        std::iota(vec.begin(), vec.end(), 0);
+        ASSERT_TRUE(compareToVector(array, vec));
+        array.shrinkToFit();
+        ASSERT_EQ(resource.allocated, 1000 * sizeof(int));
+    }
+    ASSERT_EQ(resource.allocated, 0U);
+
+    // A monotonic arena releases all arrays at once.
+    std::pmr::monotonic_buffer_resource arena{&resource};
+    for (int i{0}; i < 10; ++i)
+    {
+        Array scoped{{1, 2, 3}, &arena};
+        scoped.insert(4);
+    }
+    ASSERT_GT(resource.allocated, 0U);
+    arena.release();
+    ASSERT_EQ(resource.allocated, 0U);
+}
+
+TEST(DynamicArrayTest, MemoryResourcePropagatesToElements)
+{
+    using Array =
+        DynamicArray<std::pmr::string,
+                     std::pmr::polymorphic_allocator<std::pmr::string>>;
+    CountingResource resource;
+    Array array{&resource};
+    std::pmr::string text(100, 'a', std::pmr::new_delete_resource());
+    array.insert(text);
+    array.emplace(50, 'b');
+    for (int i{0}; i < 10; ++i)
+        array.insert(text);
+    for (const std::pmr::string& s : array)
+    {
+        ASSERT_EQ(s.get_allocator().resource(), &resource);
+    }
+    ASSERT_EQ(array[1], std::pmr::string(50, 'b'));
+}
+
+TEST(DynamicArrayTest, MemoryResourceCopyAndMove)
+{
+    using Array = DynamicArray<std::string,
+                               std::pmr::polymorphic_allocator<std::string>>;
+    CountingResource first;
+    CountingResource second;
+    Array array{{"a", "b", "c"}, &first};
+
+    // Polymorphic allocators do not propagate on copy or move assignment.
+    Array copy{array};
+    ASSERT_EQ(copy.getAllocator().resource(),
+              std::pmr::get_default_resource());
+    Array assigned{&second};
+    assigned = array;
+    ASSERT_EQ(assigned.getAllocator().resource(), &second);
+    ASSERT_TRUE(assigned == array);
+
+    std::size_t allocated{second.allocated};
+    assigned = std::move(array);
+    ASSERT_EQ(assigned.getAllocator().resource(), &second);
+    ASSERT_TRUE(compareToVector(assigned, {"a", "b", "c"}));
+    ASSERT_EQ(second.allocated, allocated);
+
+    // Storage of an equal allocator is taken over.
+    Array other{{"d"}, &second};
+    const std::string* data{other.begin()};
+    assigned = std::move(other);
+    ASSERT_EQ(assigned.begin(), data);
+
+    Array moved{std::move(assigned)};
+    ASSERT_EQ(moved.begin(), data);
+    ASSERT_EQ(moved.getAllocator().resource(), &second);
+}
+
+TEST(DynamicArrayTest, CustomAllocatorAlignsStorage)
+{
+    DynamicArray<std::uint64_t, AlignedAllocator<std::uint64_t, 4096>> array;
+    for (std::uint64_t i{0}; i < 10000; ++i)
+    {
+        array.insert(i);
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(array.begin()) % 4096, 0U);
+    }
+    while (array.size() > 10)
+        array.remove(array.size() - 1);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(array.begin()) % 4096, 0U);
+    ASSERT_EQ(array[9], 9U);
+}
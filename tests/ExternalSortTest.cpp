@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Algorithms/ExternalSort.hpp"
+
+namespace fs = std::filesystem;
+
+template <typename T>
+void writeRecords(const fs::path& path, const std::vector<T>& records)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(records.data()),
+              records.size() * sizeof(T));
+}
+
+template <typename T>
+std::vector<T> readRecords(const fs::path& path)
+{
+    std::vector<T> records(fs::file_size(path) / sizeof(T));
+    std::ifstream in(path, std::ios::binary);
+    in.read(reinterpret_cast<char*>(records.data()),
+            records.size() * sizeof(T));
+    return records;
+}
+
+std::vector<int64_t> getRandomRecords(int n)
+{
+    std::mt19937 g(7);
+    std::uniform_int_distribution<int64_t> values(-1'000'000, 1'000'000);
+    std::vector<int64_t> records(n);
+    for (int64_t& x : records)
+    {
+        x = values(g);
+    }
+    return records;
+}
+
+struct Record
+{
+    uint32_t key;
+    uint32_t order;
+};
+
+class ExternalSortTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_Directory = fs::path(::testing::TempDir()) /
+                      ::testing::UnitTest::GetInstance()
+                          ->current_test_info()
+                          ->name();
+        fs::remove_all(m_Directory);
+        fs::create_directories(m_Directory / "tmp");
+        m_Options.tempDirectory = m_Directory / "tmp";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(m_Directory);
+    }
+
+    bool noTemporaryFiles() const
+    {
+        return fs::is_empty(m_Directory / "tmp");
+    }
+
+    fs::path m_Directory;
+    sort::ExternalSortOptions m_Options;
+};
+
+TEST_F(ExternalSortTest, SortsInMemoryWhenInputFits)
+{
+    std::vector<int64_t> records{getRandomRecords(1000)};
+    writeRecords(m_Directory / "in.bin", records);
+
+    sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                m_Directory / "out.bin", m_Options);
+
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(readRecords<int64_t>(m_Directory / "out.bin"), records);
+    ASSERT_TRUE(noTemporaryFiles());
+}
+
+TEST_F(ExternalSortTest, MergesRuns)
+{
+    // 256 records per run, merged 7 at a time: 40 runs need two passes.
+    m_Options.memoryLimit = 256 * 2 * sizeof(int64_t);
+    m_Options.ioBufferSize = m_Options.memoryLimit / 8;
+    std::vector<int64_t> records{getRandomRecords(10'000)};
+    writeRecords(m_Directory / "in.bin", records);
+
+    sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                m_Directory / "out.bin", m_Options);
+
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(readRecords<int64_t>(m_Directory / "out.bin"), records);
+    ASSERT_TRUE(noTemporaryFiles());
+}
+
+TEST_F(ExternalSortTest, TinyMemoryLimit)
+{
+    m_Options.memoryLimit = 2 * sizeof(int64_t);
+    m_Options.ioBufferSize = sizeof(int64_t);
+    std::vector<int64_t> records{getRandomRecords(100)};
+    writeRecords(m_Directory / "in.bin", records);
+
+    sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                m_Directory / "out.bin", m_Options);
+
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(readRecords<int64_t>(m_Directory / "out.bin"), records);
+    ASSERT_TRUE(noTemporaryFiles());
+}
+
+TEST_F(ExternalSortTest, SortsInPlace)
+{
+    m_Options.memoryLimit = 4096;
+    m_Options.ioBufferSize = 512;
+    std::vector<int64_t> records{getRandomRecords(5000)};
+    writeRecords(m_Directory / "data.bin", records);
+
+    sort::externalSort<int64_t>(m_Directory / "data.bin",
+                                m_Directory / "data.bin", m_Options);
+
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(readRecords<int64_t>(m_Directory / "data.bin"), records);
+}
+
+TEST_F(ExternalSortTest, EmptyInput)
+{
+    writeRecords(m_Directory / "in.bin", std::vector<int64_t>{});
+
+    sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                m_Directory / "out.bin", m_Options);
+
+    ASSERT_TRUE(fs::exists(m_Directory / "out.bin"));
+    ASSERT_EQ(fs::file_size(m_Directory / "out.bin"), 0);
+}
+
+TEST_F(ExternalSortTest, CustomCompareIsStable)
+{
+    m_Options.memoryLimit = 64 * 2 * sizeof(Record);
+    m_Options.ioBufferSize = 16 * sizeof(Record);
+    std::mt19937 g(3);
+    std::uniform_int_distribution<uint32_t> keys(0, 20);
+    std::vector<Record> records(3000);
+    for (uint32_t i{0}; i < records.size(); ++i)
+    {
+        records[i] = {keys(g), i};
+    }
+    writeRecords(m_Directory / "in.bin", records);
+
+    sort::externalSort<Record>(m_Directory / "in.bin", m_Directory / "out.bin",
+                               m_Options, [](const Record& a, const Record& b) {
+                                   return a.key > b.key;
+                               });
+
+    std::vector<Record> sorted{readRecords<Record>(m_Directory / "out.bin")};
+    ASSERT_EQ(sorted.size(), records.size());
+    for (std::size_t i{1}; i < sorted.size(); ++i)
+    {
+        ASSERT_GE(sorted[i - 1].key, sorted[i].key);
+        if (sorted[i - 1].key == sorted[i].key)
+        {
+            ASSERT_LT(sorted[i - 1].order, sorted[i].order);
+        }
+    }
+    ASSERT_TRUE(noTemporaryFiles());
+}
+
+TEST_F(ExternalSortTest, InvalidArguments)
+{
+    writeRecords(m_Directory / "in.bin", std::vector<int64_t>{3, 1, 2});
+
+    sort::ExternalSortOptions tooSmall{m_Options};
+    tooSmall.memoryLimit = sizeof(int64_t);
+    ASSERT_THROW(sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                             m_Directory / "out.bin",
+                                             tooSmall),
+                 std::invalid_argument);
+
+    // 24 bytes are not a whole number of 16 byte records.
+    struct Wide
+    {
+        int64_t a;
+        int64_t b;
+    };
+    ASSERT_THROW(sort::externalSort<Wide>(m_Directory / "in.bin",
+                                          m_Directory / "out.bin", m_Options,
+                                          [](const Wide& x, const Wide& y) {
+                                              return x.a < y.a;
+                                          }),
+                 std::invalid_argument);
+
+    ASSERT_THROW(sort::externalSort<int64_t>(m_Directory / "missing.bin",
+                                             m_Directory / "out.bin",
+                                             m_Options),
+                 std::runtime_error);
+}
+
+TEST_F(ExternalSortTest, MissingTemporaryDirectory)
+{
+    m_Options.memoryLimit = 256;
+    m_Options.ioBufferSize = 64;
+    m_Options.tempDirectory = m_Directory / "missing";
+    writeRecords(m_Directory / "in.bin", getRandomRecords(1000));
+
+    ASSERT_THROW(sort::externalSort<int64_t>(m_Directory / "in.bin",
+                                             m_Directory / "out.bin",
+                                             m_Options),
+                 std::runtime_error);
+}
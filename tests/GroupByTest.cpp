@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/GroupBy.hpp"
+
+template <typename T>
+std::vector<T> getRandomKeys(int n, int maxKey)
+{
+    std::mt19937 g(static_cast<unsigned>(n));
+    std::uniform_int_distribution<int> keys(-maxKey, maxKey);
+    std::vector<T> result(n);
+    for (T& x : result)
+    {
+        x = static_cast<T>(keys(g));
+    }
+    return result;
+}
+
+template <typename T, typename Compare = std::less<>>
+std::vector<T> getSortedUnique(std::vector<T> values, Compare comp = Compare{})
+{
+    std::stable_sort(values.begin(), values.end(), comp);
+    values.erase(std::unique(values.begin(), values.end(),
+                             [&comp](const T& a, const T& b) {
+                                 return !comp(a, b) && !comp(b, a);
+                             }),
+                 values.end());
+    return values;
+}
+
+TEST(GroupByTest, SortUniqueIntegers)
+{
+    for (int n : {0, 1, 2, 3, 100, 10000})
+    {
+        for (int maxKey : {0, 1, 10, 1000, 1 << 30})
+        {
+            std::vector<int> values{getRandomKeys<int>(n, maxKey)};
+            std::vector<int> expected{getSortedUnique(values)};
+
+            values.erase(sort::sortUnique(values.begin(), values.end()),
+                         values.end());
+
+            ASSERT_EQ(values, expected);
+        }
+    }
+
+    std::vector<uint8_t> narrow{getRandomKeys<uint8_t>(5000, 100)};
+    std::vector<uint8_t> expectedNarrow{getSortedUnique(narrow)};
+    narrow.erase(sort::sortUnique(narrow.begin(), narrow.end()),
+                 narrow.end());
+    ASSERT_EQ(narrow, expectedNarrow);
+
+    // Keys that differ in the highest byte only.
+    std::vector<int64_t> wide{getRandomKeys<int64_t>(5000, 100)};
+    for (int64_t& x : wide)
+    {
+        x *= int64_t{1} << 56;
+    }
+    std::vector<int64_t> expectedWide{getSortedUnique(wide)};
+    wide.erase(sort::sortUnique(wide.begin(), wide.end()), wide.end());
+    ASSERT_EQ(wide, expectedWide);
+}
+
+TEST(GroupByTest, SortUniqueWithComparator)
+{
+    std::vector<int> values{getRandomKeys<int>(10000, 500)};
+    std::vector<int> expected{getSortedUnique(values, std::greater<>{})};
+    values.erase(
+        sort::sortUnique(values.begin(), values.end(), std::greater<>{}),
+        values.end());
+    ASSERT_EQ(values, expected);
+
+    std::vector<std::string> words;
+    for (int key : getRandomKeys<int>(3000, 200))
+    {
+        words.push_back("w" + std::to_string(key));
+    }
+    std::vector<std::string> expectedWords{getSortedUnique(words)};
+    words.erase(sort::sortUnique(words.begin(), words.end()), words.end());
+    ASSERT_EQ(words, expectedWords);
+}
+
+TEST(GroupByTest, SortUniqueKeepsFirstOfEqualElements)
+{
+    // Pairs of (key, position) compared by key only.
+    std::vector<int> keys{getRandomKeys<int>(5000, 50)};
+    std::vector<std::pair<int, int>> values;
+    for (int i{0}; i < static_cast<int>(keys.size()); ++i)
+    {
+        values.emplace_back(keys[i], i);
+    }
+    auto byKey{[](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    }};
+    std::vector<std::pair<int, int>> expected{getSortedUnique(values, byKey)};
+
+    values.erase(sort::sortUnique(values.begin(), values.end(), byKey),
+                 values.end());
+
+    ASSERT_EQ(values, expected);
+}
+
+TEST(GroupByTest, SortUniqueFloatingPoint)
+{
+    std::vector<double> values{2.5, -1.0, 0.0, 2.5, -0.0, -1.0, 7.0, 0.0};
+
+    values.erase(sort::sortUnique(values.begin(), values.end()),
+                 values.end());
+
+    // Radix keys keep -0.0 and 0.0 apart.
+    ASSERT_EQ(values.size(), 5U);
+    ASSERT_EQ(values[0], -1.0);
+    ASSERT_TRUE(std::signbit(values[1]));
+    ASSERT_FALSE(std::signbit(values[2]));
+    ASSERT_EQ(values[3], 2.5);
+    ASSERT_EQ(values[4], 7.0);
+}
+
+TEST(GroupByTest, SortAndCount)
+{
+    for (int n : {0, 1, 5, 10000})
+    {
+        for (int maxKey : {0, 20, 1 << 20})
+        {
+            std::vector<int> keys{getRandomKeys<int>(n, maxKey)};
+            std::map<int, std::size_t> expected;
+            for (int key : keys)
+            {
+                ++expected[key];
+            }
+            std::vector<std::size_t> counts(keys.size());
+
+            keys.erase(
+                sort::sortAndCount(keys.begin(), keys.end(), counts.begin()),
+                keys.end());
+
+            ASSERT_EQ(keys.size(), expected.size());
+            auto it{expected.begin()};
+            for (std::size_t i{0}; i < keys.size(); ++i, ++it)
+            {
+                ASSERT_EQ(keys[i], it->first);
+                ASSERT_EQ(counts[i], it->second);
+            }
+        }
+    }
+
+    std::vector<std::string> words{"b", "a", "c", "a", "b", "a"};
+    std::vector<std::size_t> counts;
+    auto end{sort::sortAndCount(words.begin(), words.end(),
+                                std::back_inserter(counts), std::greater<>{})};
+    words.erase(end, words.end());
+    ASSERT_EQ(words, (std::vector<std::string>{"c", "b", "a"}));
+    ASSERT_EQ(counts, (std::vector<std::size_t>{1, 2, 3}));
+}
+
+TEST(GroupByTest, GroupBySumMinMax)
+{
+    int n{20000};
+    std::vector<int64_t> keys{getRandomKeys<int64_t>(n, 300)};
+    std::vector<int64_t> values{getRandomKeys<int64_t>(n, 1 << 20)};
+    std::map<int64_t, int64_t> sums;
+    std::map<int64_t, int64_t> minima;
+    std::map<int64_t, int64_t> maxima;
+    for (int i{0}; i < n; ++i)
+    {
+        sums[keys[i]] += values[i];
+        auto [minimum, newMin]{minima.emplace(keys[i], values[i])};
+        minimum->second = std::min(minimum->second, values[i]);
+        auto [maximum, newMax]{maxima.emplace(keys[i], values[i])};
+        maximum->second = std::max(maximum->second, values[i]);
+    }
+
+    auto check{[](const std::vector<int64_t>& groups,
+                  const std::vector<int64_t>& aggregates,
+                  const std::map<int64_t, int64_t>& expected) {
+        ASSERT_EQ(groups.size(), expected.size());
+        auto it{expected.begin()};
+        for (std::size_t i{0}; i < groups.size(); ++i, ++it)
+        {
+            ASSERT_EQ(groups[i], it->first);
+            ASSERT_EQ(aggregates[i], it->second);
+        }
+    }};
+
+    std::vector<int64_t> groups{keys};
+    std::vector<int64_t> aggregates(n);
+    groups.erase(sort::groupBy(groups.begin(), groups.end(), values.begin(),
+                               aggregates.begin(), std::plus<>{}),
+                 groups.end());
+    check(groups, aggregates, sums);
+
+    groups = keys;
+    groups.erase(sort::groupBy(groups.begin(), groups.end(), values.begin(),
+                               aggregates.begin(), sort::Min{}),
+                 groups.end());
+    check(groups, aggregates, minima);
+
+    // Aggregates may overwrite the payload column.
+    groups = keys;
+    std::vector<int64_t> inPlace{values};
+    groups.erase(sort::groupBy(groups.begin(), groups.end(), inPlace.begin(),
+                               inPlace.begin(), sort::Max{}),
+                 groups.end());
+    check(groups, inPlace, maxima);
+}
+
+TEST(GroupByTest, GroupByFoldsInInputOrder)
+{
+    // Concatenation is associative but not commutative.
+    std::vector<std::string> keys{"x", "y", "x", "z", "y", "x"};
+    std::vector<std::string> values{"1", "2", "3", "4", "5", "6"};
+    std::vector<std::string> aggregates;
+
+    keys.erase(sort::groupBy(keys.begin(), keys.end(), values.begin(),
+                             std::back_inserter(aggregates), std::plus<>{}),
+               keys.end());
+
+    ASSERT_EQ(keys, (std::vector<std::string>{"x", "y", "z"}));
+    ASSERT_EQ(aggregates, (std::vector<std::string>{"136", "25", "4"}));
+
+    std::vector<int> ids{getRandomKeys<int>(10000, 40)};
+    std::vector<std::string> digits(ids.size());
+    std::map<int, std::string> expected;
+    for (std::size_t i{0}; i < ids.size(); ++i)
+    {
+        digits[i] = std::to_string(i % 10);
+        expected[ids[i]] += digits[i];
+    }
+    std::vector<std::string> joined;
+    ids.erase(sort::groupBy(ids.begin(), ids.end(), digits.begin(),
+                            std::back_inserter(joined), std::plus<>{}),
+              ids.end());
+    ASSERT_EQ(ids.size(), expected.size());
+    auto it{expected.begin()};
+    for (std::size_t i{0}; i < ids.size(); ++i, ++it)
+    {
+        ASSERT_EQ(ids[i], it->first);
+        ASSERT_EQ(joined[i], it->second);
+    }
+}
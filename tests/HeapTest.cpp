@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include "DataStructures/Heap.hpp"
 
 TEST(HeapTest, CreateEmptyHeap)
@@ -155,3 +157,25 @@ TEST(HeapTest, CustomCompareFunction)
     maxHeap.pop();
     ASSERT_TRUE(maxHeap.empty());
 }
+
+TEST(HeapTest, MemoryResource)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    Heap<int, std::pmr::polymorphic_allocator<int>> maxHeap(
+        [](int a, int b) { return a > b; }, &arena);
+    for (int i{0}; i < 1000; ++i)
+    {
+        maxHeap.insert(i);
+    }
+    for (int i{999}; i >= 0; --i)
+    {
+        ASSERT_EQ(maxHeap.peek(), i);
+        maxHeap.pop();
+    }
+    ASSERT_TRUE(maxHeap.empty());
+
+    Heap<int, std::pmr::polymorphic_allocator<int>> minHeap{&arena};
+    minHeap.insert(2);
+    minHeap.insert(1);
+    ASSERT_EQ(minHeap.peek(), 1);
+}
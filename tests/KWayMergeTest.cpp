@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/KWayMerge.hpp"
+
+std::vector<std::vector<int>> getSortedRuns(int k, int maxSize, int maxValue)
+{
+    std::mt19937 g(static_cast<unsigned>(k));
+    std::uniform_int_distribution<int> sizes(0, maxSize);
+    std::uniform_int_distribution<int> values(0, maxValue);
+    std::vector<std::vector<int>> runs(k);
+    for (std::vector<int>& run : runs)
+    {
+        run.resize(sizes(g));
+        for (int& x : run)
+        {
+            x = values(g);
+        }
+        std::sort(run.begin(), run.end());
+    }
+    return runs;
+}
+
+template <typename T>
+std::vector<std::pair<const T*, const T*>>
+getRanges(const std::vector<std::vector<T>>& runs)
+{
+    std::vector<std::pair<const T*, const T*>> ranges;
+    for (const std::vector<T>& run : runs)
+    {
+        ranges.emplace_back(run.data(), run.data() + run.size());
+    }
+    return ranges;
+}
+
+// Stream of the multiples of a number below a limit.
+struct MultiplesStream
+{
+    bool empty() const
+    {
+        return value >= limit;
+    }
+
+    int front() const
+    {
+        return value;
+    }
+
+    void pop()
+    {
+        value += step;
+    }
+
+    int value;
+    int step;
+    int limit;
+};
+
+TEST(KWayMergeTest, MergeSortedRanges)
+{
+    for (int k : {0, 1, 2, 3, 7, 64, 100, 257})
+    {
+        std::vector<std::vector<int>> runs{getSortedRuns(k, 200, 1000)};
+        std::vector<int> expected;
+        for (const std::vector<int>& run : runs)
+        {
+            expected.insert(expected.end(), run.begin(), run.end());
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<int> merged(expected.size());
+
+        auto end{sort::kWayMerge(getRanges(runs), merged.begin())};
+
+        ASSERT_EQ(end, merged.end());
+        ASSERT_EQ(merged, expected);
+    }
+}
+
+TEST(KWayMergeTest, MergeIsStable)
+{
+    struct Record
+    {
+        int key;
+        int run;
+        int position;
+    };
+    std::vector<std::vector<int>> keys{getSortedRuns(37, 100, 20)};
+    std::vector<std::vector<Record>> runs(keys.size());
+    for (std::size_t i{0}; i < keys.size(); ++i)
+    {
+        for (std::size_t j{0}; j < keys[i].size(); ++j)
+        {
+            runs[i].push_back({keys[i][j], static_cast<int>(i),
+                               static_cast<int>(j)});
+        }
+    }
+    std::vector<Record> merged;
+
+    sort::kWayMerge(getRanges(runs), std::back_inserter(merged),
+                    [](const Record& a, const Record& b) {
+                        return a.key < b.key;
+                    });
+
+    for (std::size_t i{1}; i < merged.size(); ++i)
+    {
+        const Record& previous{merged[i - 1]};
+        const Record& current{merged[i]};
+        ASSERT_LE(previous.key, current.key);
+        if (previous.key == current.key)
+        {
+            ASSERT_TRUE(previous.run < current.run ||
+                        (previous.run == current.run &&
+                         previous.position < current.position));
+        }
+    }
+}
+
+TEST(KWayMergeTest, MergeWithComparator)
+{
+    std::vector<std::vector<int>> runs{{9, 5, 1}, {}, {8, 8, 2}, {7}};
+    std::vector<int> merged;
+
+    sort::kWayMerge(getRanges(runs), std::back_inserter(merged),
+                    std::greater<>{});
+
+    ASSERT_EQ(merged, (std::vector<int>{9, 8, 8, 7, 5, 2, 1}));
+}
+
+TEST(KWayMergeTest, LoserTreeOverStreams)
+{
+    std::vector<MultiplesStream> streams{{0, 3, 20}, {0, 5, 20}, {7, 7, 20}};
+    sort::LoserTree<MultiplesStream> tree(streams.data(),
+                                          streams.data() + streams.size());
+    std::vector<int> merged;
+    std::vector<std::size_t> winners;
+    while (!tree.empty())
+    {
+        merged.push_back(tree.front());
+        winners.push_back(tree.winner());
+        tree.pop();
+    }
+
+    ASSERT_EQ(merged,
+              (std::vector<int>{0, 0, 3, 5, 6, 7, 9, 10, 12, 14, 15, 15, 18}));
+    ASSERT_EQ(winners, (std::vector<std::size_t>{0, 1, 0, 1, 0, 2, 0, 1, 0, 2,
+                                                 0, 1, 0}));
+}
+
+TEST(KWayMergeTest, BatchedPopAndNestedTrees)
+{
+    std::vector<std::vector<int>> runs{getSortedRuns(10, 500, 100000)};
+    std::vector<int> expected;
+    for (const std::vector<int>& run : runs)
+    {
+        expected.insert(expected.end(), run.begin(), run.end());
+    }
+    std::sort(expected.begin(), expected.end());
+
+    // Two trees over half of the runs each, merged by a third tree.
+    using RangeTree = sort::LoserTree<sort_impl::RangeStream<const int*>>;
+    std::vector<sort_impl::RangeStream<const int*>> streams;
+    for (const auto& [first, last] : getRanges(runs))
+    {
+        streams.push_back({first, last});
+    }
+    std::vector<RangeTree> halves{
+        RangeTree(streams.data(), streams.data() + 5),
+        RangeTree(streams.data() + 5, streams.data() + 10)};
+    sort::LoserTree<RangeTree> tree(halves.data(),
+                                    halves.data() + halves.size());
+
+    std::vector<int> merged;
+    std::vector<int> batch(64);
+    while (!tree.empty())
+    {
+        auto end{tree.pop(batch.begin(), batch.size())};
+        ASSERT_TRUE(end == batch.end() || tree.empty());
+        merged.insert(merged.end(), batch.begin(), end);
+    }
+
+    ASSERT_EQ(merged, expected);
+}
+
+// Stream of numbers below a limit as strings padded past the small string
+// buffer, returned by value.
+struct PaddedNumberStream
+{
+    bool empty() const
+    {
+        return value >= limit;
+    }
+
+    std::string front() const
+    {
+        std::string number{std::to_string(value)};
+        return std::string(40 - number.size(), '0') + number;
+    }
+
+    void pop()
+    {
+        value += step;
+    }
+
+    int value;
+    int step;
+    int limit;
+};
+
+TEST(KWayMergeTest, BatchedPopOfStrings)
+{
+    // Elements returned by value are moved out of the tree.
+    std::vector<PaddedNumberStream> streams{{0, 2, 100}, {1, 2, 100}};
+    sort::LoserTree<PaddedNumberStream> tree(streams.data(),
+                                             streams.data() + streams.size());
+    std::vector<std::string> merged(100);
+    ASSERT_TRUE(tree.pop(merged.begin(), merged.size()) == merged.end());
+    ASSERT_TRUE(tree.empty());
+    for (int i{0}; i < 100; ++i)
+    {
+        ASSERT_EQ(std::stoi(merged[i]), i);
+    }
+
+    // Elements read from ranges are copied and the runs stay intact.
+    std::vector<std::string> even(merged.begin(), merged.begin() + 50);
+    std::vector<std::string> odd(merged.begin() + 50, merged.end());
+    std::vector<sort_impl::RangeStream<const std::string*>> ranges{
+        {even.data(), even.data() + even.size()},
+        {odd.data(), odd.data() + odd.size()}};
+    sort::LoserTree<sort_impl::RangeStream<const std::string*>> rangeTree(
+        ranges.data(), ranges.data() + ranges.size());
+    std::vector<std::string> copied(100);
+    rangeTree.pop(copied.begin(), copied.size());
+    ASSERT_EQ(copied, merged);
+    ASSERT_EQ(even.front(), merged.front());
+}
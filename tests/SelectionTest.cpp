@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Algorithms/Selection.hpp"
+
+std::vector<int> getRandomValues(int n, int maxValue)
+{
+    std::mt19937 g(13);
+    std::uniform_int_distribution<int> values(0, maxValue);
+    std::vector<int> result(n);
+    for (int& x : result)
+    {
+        x = values(g);
+    }
+    return result;
+}
+
+TEST(SelectionTest, NthElementPlacesElement)
+{
+    std::vector<int> numbers{getRandomValues(10000, 1000000)};
+    std::vector<int> sorted{numbers};
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int nth : {0, 1, 17, 5000, 9998, 9999})
+    {
+        std::vector<int> selected{numbers};
+        auto it{selected.begin() + nth};
+
+        sort::nthElement(selected.begin(), it, selected.end());
+
+        ASSERT_EQ(*it, sorted[nth]);
+        ASSERT_TRUE(std::all_of(selected.begin(), it,
+                                [&](int x) { return x <= *it; }));
+        ASSERT_TRUE(std::all_of(it, selected.end(),
+                                [&](int x) { return x >= *it; }));
+    }
+}
+
+TEST(SelectionTest, NthElementHandlesPatterns)
+{
+    int n{100000};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> equal(n, 7);
+    std::vector<int> fewUnique{getRandomValues(n, 3)};
+    std::vector<int> organPipe(n);
+    for (int i{0}; i < n; ++i)
+    {
+        organPipe[i] = std::min(i, n - i);
+    }
+
+    for (std::vector<int> numbers :
+         {sorted, reversed, equal, fewUnique, organPipe})
+    {
+        std::vector<int> expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        auto nth{numbers.begin() + n / 3};
+
+        sort::nthElement(numbers.begin(), nth, numbers.end());
+
+        ASSERT_EQ(*nth, expected[n / 3]);
+    }
+}
+
+TEST(SelectionTest, NthElementComparisonsStayLinear)
+{
+    int n{1 << 16};
+    std::vector<int> numbers{getRandomValues(n, 1 << 30)};
+    long comparisons{0};
+
+    sort::nthElement(numbers.begin(), numbers.begin() + n / 2, numbers.end(),
+                     [&comparisons](int a, int b) {
+                         ++comparisons;
+                         return a < b;
+                     });
+
+    ASSERT_LT(comparisons, 8L * n);
+}
+
+TEST(SelectionTest, NthElementEmptyAndEnd)
+{
+    std::vector<int> empty;
+    std::vector<int> numbers{3, 1, 2};
+
+    sort::nthElement(empty.begin(), empty.end(), empty.end());
+    sort::nthElement(numbers.begin(), numbers.end(), numbers.end());
+
+    ASSERT_EQ(numbers, (std::vector<int>{3, 1, 2}));
+}
+
+TEST(SelectionTest, PartialSortSortsPrefix)
+{
+    std::vector<int> numbers{getRandomValues(10000, 500)};
+    std::vector<int> sorted{numbers};
+    std::sort(sorted.begin(), sorted.end());
+
+    for (int k : {0, 1, 100, 9999, 10000})
+    {
+        std::vector<int> partial{numbers};
+
+        sort::partialSort(partial.begin(), partial.begin() + k,
+                          partial.end());
+
+        ASSERT_TRUE(std::equal(partial.begin(), partial.begin() + k,
+                               sorted.begin()));
+        std::sort(partial.begin(), partial.end());
+        ASSERT_EQ(partial, sorted);
+    }
+}
+
+TEST(SelectionTest, PartialSortWithComparator)
+{
+    std::vector<std::string> words{"kiwi", "apple", "fig", "pear", "plum"};
+
+    sort::partialSort(words.begin(), words.begin() + 2, words.end(),
+                      std::greater<>{});
+
+    ASSERT_EQ(words[0], "plum");
+    ASSERT_EQ(words[1], "pear");
+}
+
+TEST(SelectionTest, TopKKeepsLargest)
+{
+    std::vector<int> numbers{getRandomValues(100000, 1 << 30)};
+    std::vector<int> expected{numbers};
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+    expected.resize(100);
+
+    sort::TopK<int> top(100);
+    for (std::size_t i{0}; i < numbers.size(); i += 4096)
+    {
+        std::size_t end{std::min(i + 4096, numbers.size())};
+        top.push(numbers.begin() + i, numbers.begin() + end);
+    }
+
+    ASSERT_EQ(top.size(), 100);
+    ASSERT_EQ(top.values(), expected);
+}
+
+TEST(SelectionTest, TopKWithComparator)
+{
+    sort::TopK<int, std::less<>> bottom(3);
+    for (int x : {5, 9, 1, 7, 3, 8, 2})
+    {
+        bottom.push(x);
+    }
+
+    ASSERT_EQ(bottom.values(), (std::vector<int>{1, 2, 3}));
+}
+
+TEST(SelectionTest, TopKWithFewerValuesThanK)
+{
+    sort::TopK<int> top(10);
+    top.push(2);
+    top.push(5);
+    top.push(1);
+
+    ASSERT_EQ(top.size(), 3);
+    ASSERT_EQ(top.values(), (std::vector<int>{5, 2, 1}));
+
+    top.clear();
+    ASSERT_EQ(top.size(), 0);
+    ASSERT_TRUE(top.values().empty());
+}
+
+TEST(SelectionTest, TopKZero)
+{
+    sort::TopK<int> top(0);
+    top.push(1);
+
+    ASSERT_EQ(top.size(), 0);
+    ASSERT_TRUE(top.values().empty());
+}
@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "DataStructures/SmallDynamicArray.hpp"
+
+// Copies throw once `throwOnCopy` is set.
+struct ThrowingCopy
+{
+    explicit ThrowingCopy(int v) : value{v}
+    {
+    }
+
+    ThrowingCopy(const ThrowingCopy& other) : value{other.value}
+    {
+        if (throwOnCopy)
+        {
+            throw std::runtime_error("Copy failed!");
+        }
+    }
+
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    int value;
+    static inline bool throwOnCopy{false};
+};
+
+template <typename T, uint32_t N>
+bool compareToVector(const SmallDynamicArray<T, N>& array,
+                     const std::vector<T>& vec)
+{
+    if (array.size() != vec.size())
+        return false;
+
+    for (uint32_t i{0}; i < array.size(); ++i)
+    {
+        if (array[i] != vec[i])
+            return false;
+    }
+    return true;
+}
+
+TEST(SmallDynamicArrayTest, InitDefault)
+{
+    SmallDynamicArray<int, 4> array;
+    ASSERT_EQ(array.size(), 0);
+    ASSERT_EQ(array.capacity(), 4);
+    ASSERT_TRUE(array.isInline());
+    ASSERT_TRUE(array.empty());
+}
+
+TEST(SmallDynamicArrayTest, InitList)
+{
+    SmallDynamicArray<int, 4> small{1, 2, 3};
+    ASSERT_TRUE(small.isInline());
+    ASSERT_TRUE(compareToVector(small, {1, 2, 3}));
+
+    SmallDynamicArray<int, 2> large{1, 2, 3};
+    ASSERT_FALSE(large.isInline());
+    ASSERT_TRUE(compareToVector(large, {1, 2, 3}));
+}
+
+TEST(SmallDynamicArrayTest, SpillsToHeapAndBack)
+{
+    SmallDynamicArray<std::string, 4> array;
+    std::vector<std::string> vec;
+    for (int i{0}; i < 4; ++i)
+    {
+        array.insert(std::to_string(i));
+        vec.push_back(std::to_string(i));
+    }
+    ASSERT_TRUE(array.isInline());
+    ASSERT_EQ(array.capacity(), 4);
+
+    array.insert("4");
+    vec.push_back("4");
+    ASSERT_FALSE(array.isInline());
+    ASSERT_EQ(array.capacity(), 8);
+    for (int i{5}; i < 100; ++i)
+    {
+        array.insert(std::to_string(i));
+        vec.push_back(std::to_string(i));
+    }
+    ASSERT_TRUE(compareToVector(array, vec));
+    ASSERT_EQ(array.capacity(), 128);
+
+    // Capacity halves below a quarter, so up to two elements stay on the
+    // heap.
+    while (array.size() > 3)
+    {
+        array.remove(0);
+        vec.erase(vec.begin());
+    }
+    ASSERT_EQ(array.capacity(), 8);
+    ASSERT_TRUE(compareToVector(array, vec));
+    array.remove(0, 2);
+    vec.erase(vec.begin(), vec.begin() + 2);
+    ASSERT_TRUE(array.isInline());
+    ASSERT_EQ(array.capacity(), 4);
+    ASSERT_TRUE(compareToVector(array, vec));
+}
+
+TEST(SmallDynamicArrayTest, CopyConstructorAndOperator)
+{
+    SmallDynamicArray<std::string, 2> small{"a"};
+    SmallDynamicArray<std::string, 2> large{"a", "b", "c"};
+
+    SmallDynamicArray<std::string, 2> smallCopy{small};
+    SmallDynamicArray<std::string, 2> largeCopy{large};
+    ASSERT_TRUE(smallCopy == small);
+    ASSERT_TRUE(largeCopy == large);
+    ASSERT_NE(largeCopy.begin(), large.begin());
+
+    smallCopy = large;
+    largeCopy = small;
+    ASSERT_TRUE(smallCopy == large);
+    ASSERT_TRUE(largeCopy == small);
+    ASSERT_TRUE(largeCopy != large);
+}
+
+TEST(SmallDynamicArrayTest, MoveConstructorAndOperator)
+{
+    SmallDynamicArray<std::string, 2> small{std::string(100, 'a')};
+    SmallDynamicArray<std::string, 2> large{"a", "b", "c"};
+    const char* buffer{small[0].data()};
+    const std::string* data{large.begin()};
+
+    SmallDynamicArray<std::string, 2> movedSmall{std::move(small)};
+    ASSERT_TRUE(movedSmall.isInline());
+    ASSERT_EQ(movedSmall[0].data(), buffer);
+    ASSERT_TRUE(small.empty());
+    ASSERT_TRUE(small.isInline());
+
+    SmallDynamicArray<std::string, 2> movedLarge{std::move(large)};
+    ASSERT_EQ(movedLarge.begin(), data);
+    ASSERT_TRUE(large.empty());
+    ASSERT_TRUE(large.isInline());
+
+    movedSmall = std::move(movedLarge);
+    ASSERT_EQ(movedSmall.begin(), data);
+    ASSERT_TRUE(compareToVector(movedSmall, {"a", "b", "c"}));
+    movedLarge = SmallDynamicArray<std::string, 2>{"d"};
+    ASSERT_TRUE(compareToVector(movedLarge, {"d"}));
+
+    // Moved from arrays stay usable.
+    small.insert("e");
+    large.insert("f");
+    ASSERT_EQ(small[0], "e");
+    ASSERT_EQ(large[0], "f");
+}
+
+TEST(SmallDynamicArrayTest, RangeLoop)
+{
+    SmallDynamicArray<int, 8> array;
+    for (int i{0}; i < 20; ++i)
+        array.insert(i);
+    int expected{0};
+    for (int x : array)
+    {
+        ASSERT_EQ(x, expected);
+        ++expected;
+    }
+    ASSERT_EQ(expected, 20);
+}
+
+TEST(SmallDynamicArrayTest, RemoveInsertAndAppendRanges)
+{
+    SmallDynamicArray<std::string, 4> array{"a", "e"};
+    std::vector<std::string> middle{"b", "c", "d"};
+    array.insert(1, middle.begin(), middle.end());
+    ASSERT_TRUE(compareToVector(array, {"a", "b", "c", "d", "e"}));
+    array.remove(1, 4);
+    ASSERT_TRUE(compareToVector(array, {"a", "e"}));
+    ASSERT_EQ(array.capacity(), 8);
+    array.append(std::make_move_iterator(middle.begin()),
+                 std::make_move_iterator(middle.end()));
+    ASSERT_TRUE(compareToVector(array, {"a", "e", "b", "c", "d"}));
+    array.swapRemove(0);
+    ASSERT_TRUE(compareToVector(array, {"d", "e", "b", "c"}));
+
+    EXPECT_THROW(array.insert(5, middle.begin(), middle.end()),
+                 std::out_of_range);
+    EXPECT_THROW(array.remove(2, 5), std::out_of_range);
+    EXPECT_THROW(array.swapRemove(4), std::out_of_range);
+}
+
+TEST(SmallDynamicArrayTest, ReserveAndShrinkToFit)
+{
+    SmallDynamicArray<int, 4> array;
+    array.reserve(3);
+    ASSERT_TRUE(array.isInline());
+    array.reserve(100);
+    ASSERT_FALSE(array.isInline());
+    ASSERT_EQ(array.capacity(), 100);
+    for (int i{0}; i < 50; ++i)
+        array.insert(i);
+    array.shrinkToFit();
+    ASSERT_EQ(array.capacity(), 50);
+    array.remove(2, 50);
+    array.shrinkToFit();
+    ASSERT_TRUE(array.isInline());
+    ASSERT_TRUE(compareToVector(array, {0, 1}));
+}
+
+TEST(SmallDynamicArrayTest, MoveOnlyElements)
+{
+    SmallDynamicArray<std::unique_ptr<int>, 2> pointers;
+    for (int i{0}; i < 10; ++i)
+        pointers.emplace(std::make_unique<int>(i));
+    pointers.remove(0);
+    while (pointers.size() > 1)
+        pointers.remove(pointers.size() - 1);
+    pointers.shrinkToFit();
+    ASSERT_TRUE(pointers.isInline());
+    ASSERT_EQ(*pointers[0], 1);
+
+    SmallDynamicArray<std::unique_ptr<int>, 2> moved{std::move(pointers)};
+    ASSERT_EQ(*moved[0], 1);
+}
+
+TEST(SmallDynamicArrayTest, ThrowingCopyKeepsElements)
+{
+    using Array = SmallDynamicArray<ThrowingCopy, 2>;
+    Array array;
+    array.emplace(1);
+    array.emplace(2);
+    ThrowingCopy::throwOnCopy = true;
+    // Without a noexcept move constructor growth has to copy.
+    EXPECT_THROW(array.emplace(3), std::runtime_error);
+    ThrowingCopy::throwOnCopy = false;
+    ASSERT_TRUE(array.isInline());
+    ASSERT_EQ(array.size(), 2);
+    ASSERT_EQ(array[1].value, 2);
+
+    Array large;
+    for (int i{0}; i < 5; ++i)
+        large.emplace(i);
+    ThrowingCopy::throwOnCopy = true;
+    EXPECT_THROW(Array{large}, std::runtime_error);
+    ThrowingCopy::throwOnCopy = false;
+}
+
+TEST(SmallDynamicArrayTest, InsertElementOfSameArray)
+{
+    SmallDynamicArray<std::string, 2> array{std::string(100, 'a'), "b"};
+    array.insert(array[0]);
+    ASSERT_EQ(array[2], std::string(100, 'a'));
+}
+
+TEST(SmallDynamicArrayTest, AccessIncorrectIndex)
+{
+    SmallDynamicArray<int, 4> array{1, 2};
+    EXPECT_THROW(
+        {
+            try
+            {
+                array[2];
+            }
+            catch (const std::out_of_range& e)
+            {
+                ASSERT_STREQ("Index out of range!", e.what());
+                throw;
+            }
+        },
+        std::out_of_range);
+    EXPECT_THROW(array.remove(2), std::out_of_range);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Algorithms/SortingNetworks.hpp"
+
+const std::vector<sort::SimdLevel> LEVELS{
+    sort::SimdLevel::Scalar, sort::SimdLevel::SSE4, sort::SimdLevel::AVX2};
+
+template <typename T>
+std::vector<T> getRandomValues(int n, int seed)
+{
+    std::mt19937 g(seed);
+    std::uniform_int_distribution<int> values(-100, 100);
+    std::vector<T> result(n);
+    for (T& x : result)
+    {
+        x = static_cast<T>(values(g));
+    }
+    return result;
+}
+
+class SortingNetworksTest : public ::testing::Test
+{
+  protected:
+    void TearDown() override
+    {
+        sort::setSimdLevel(sort::SimdLevel::AVX2);
+    }
+};
+
+TEST_F(SortingNetworksTest, SetLevelIsLimitedByCpu)
+{
+    sort::SimdLevel best{sort::setSimdLevel(sort::SimdLevel::AVX2)};
+    ASSERT_EQ(sort::simdLevel(), best);
+    ASSERT_EQ(sort::setSimdLevel(sort::SimdLevel::Scalar),
+              sort::SimdLevel::Scalar);
+    ASSERT_EQ(sort::simdLevel(), sort::SimdLevel::Scalar);
+}
+
+TEST_F(SortingNetworksTest, NetworkSortIntegers)
+{
+    for (sort::SimdLevel level : LEVELS)
+    {
+        sort::setSimdLevel(level);
+        for (int n{0}; n <= sort::NETWORK_SORT_MAX + 8; ++n)
+        {
+            std::vector<int> numbers{getRandomValues<int>(n, n)};
+            numbers.push_back(-1);
+            std::vector<int> expected{numbers};
+            std::sort(expected.begin(), expected.end() - 1);
+
+            sort::networkSort(numbers.data(), n);
+
+            ASSERT_EQ(numbers, expected);
+        }
+    }
+}
+
+TEST_F(SortingNetworksTest, NetworkSortFloats)
+{
+    for (sort::SimdLevel level : LEVELS)
+    {
+        sort::setSimdLevel(level);
+        for (int n{0}; n <= sort::NETWORK_SORT_MAX; ++n)
+        {
+            std::vector<float> numbers{getRandomValues<float>(n, n)};
+            if (n > 1)
+            {
+                numbers[0] = std::numeric_limits<float>::infinity();
+                numbers[1] = -std::numeric_limits<float>::infinity();
+            }
+            std::vector<float> expected{numbers};
+            std::sort(expected.begin(), expected.end());
+
+            sort::networkSort(numbers.data(), n);
+
+            ASSERT_EQ(numbers, expected);
+        }
+    }
+}
+
+TEST_F(SortingNetworksTest, NetworkSortKeepsMaximumValues)
+{
+    std::vector<int> numbers{std::numeric_limits<int>::max(), 3,
+                             std::numeric_limits<int>::min(), 0, 3};
+    std::vector<int> expected{numbers};
+    std::sort(expected.begin(), expected.end());
+
+    sort::networkSort(numbers.data(), static_cast<int>(numbers.size()));
+
+    ASSERT_EQ(numbers, expected);
+}
+
+TEST_F(SortingNetworksTest, BitonicMergeIntegers)
+{
+    for (sort::SimdLevel level : LEVELS)
+    {
+        sort::setSimdLevel(level);
+        for (int nLeft : {0, 1, 7, 8, 9, 64, 100})
+        {
+            for (int nRight : {0, 1, 3, 8, 17, 64, 1000})
+            {
+                std::vector<int> left{getRandomValues<int>(nLeft, nLeft)};
+                std::vector<int> right{getRandomValues<int>(nRight, 7)};
+                std::sort(left.begin(), left.end());
+                std::sort(right.begin(), right.end());
+                std::vector<int> expected(nLeft + nRight);
+                std::merge(left.begin(), left.end(), right.begin(),
+                           right.end(), expected.begin());
+                std::vector<int> out(nLeft + nRight + 1, -1);
+
+                sort::bitonicMerge(left.data(), nLeft, right.data(), nRight,
+                                   out.data());
+
+                ASSERT_EQ(out.back(), -1);
+                out.pop_back();
+                ASSERT_EQ(out, expected);
+            }
+        }
+    }
+}
+
+TEST_F(SortingNetworksTest, BitonicMergeFloats)
+{
+    for (sort::SimdLevel level : LEVELS)
+    {
+        sort::setSimdLevel(level);
+        std::vector<float> left{getRandomValues<float>(333, 1)};
+        std::vector<float> right{getRandomValues<float>(45, 2)};
+        std::sort(left.begin(), left.end());
+        std::sort(right.begin(), right.end());
+        std::vector<float> expected(left.size() + right.size());
+        std::merge(left.begin(), left.end(), right.begin(), right.end(),
+                   expected.begin());
+        std::vector<float> out(expected.size());
+
+        sort::bitonicMerge(left.data(), static_cast<int>(left.size()),
+                           right.data(), static_cast<int>(right.size()),
+                           out.data());
+
+        ASSERT_EQ(out, expected);
+    }
+}
@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Algorithms/Selection.hpp"
+#include "Algorithms/Sorting.hpp"
+#include "Algorithms/SortingStats.hpp"
+#include "Algorithms/StringSort.hpp"
+
+std::vector<int> getShuffledValues(int n)
+{
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::mt19937(n));
+    return values;
+}
+
+// Comparator counting its own calls to check the counters against.
+struct CountedLess
+{
+    bool operator()(int a, int b) const
+    {
+        calls->fetch_add(1, std::memory_order_relaxed);
+        return a < b;
+    }
+
+    std::atomic<std::uint64_t>* calls;
+};
+
+TEST(SortingStatsTest, InstrumentationIsEnabled)
+{
+    ASSERT_TRUE(sort::INSTRUMENTATION_ENABLED);
+}
+
+TEST(SortingStatsTest, CountsEveryComparison)
+{
+    using Sort = void (*)(std::vector<int>::iterator,
+                          std::vector<int>::iterator, CountedLess);
+    std::vector<Sort> sorts{
+        sort::bubbleSort,    sort::selectionSort, sort::mergeSort,
+        sort::timSort,       sort::insertionSort, sort::quickSort,
+        sort::pdqSort,       sort::heapSort,
+    };
+    for (Sort sortFunction : sorts)
+    {
+        std::vector<int> values{getShuffledValues(1000)};
+        std::atomic<std::uint64_t> calls{0};
+        sort::resetSortStats();
+
+        sortFunction(values.begin(), values.end(), CountedLess{&calls});
+
+        ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+        ASSERT_GT(calls.load(), 0U);
+        ASSERT_EQ(sort::sortStats().comparisons, calls.load());
+    }
+}
+
+TEST(SortingStatsTest, BubbleSortSwapsInversions)
+{
+    int n{200};
+    std::vector<int> values(n);
+    std::iota(values.rbegin(), values.rend(), 0);
+    sort::resetSortStats();
+
+    sort::bubbleSort(values.begin(), values.end());
+
+    sort::SortStats stats{sort::sortStats()};
+    auto pairs{static_cast<std::uint64_t>(n * (n - 1) / 2)};
+    ASSERT_EQ(stats.comparisons, pairs);
+    ASSERT_EQ(stats.swaps, pairs);
+    ASSERT_EQ(stats.moves, 0U);
+    ASSERT_EQ(stats.maxDepth, 0U);
+    ASSERT_EQ(stats.scratchBytes, 0U);
+}
+
+TEST(SortingStatsTest, InsertionSortMovesOnSortedInput)
+{
+    int n{1000};
+    std::vector<int> values(n);
+    std::iota(values.begin(), values.end(), 0);
+    sort::resetSortStats();
+
+    sort::insertionSort(values.begin(), values.end());
+
+    sort::SortStats stats{sort::sortStats()};
+    ASSERT_EQ(stats.comparisons, static_cast<std::uint64_t>(n - 1));
+    ASSERT_EQ(stats.moves, static_cast<std::uint64_t>(2 * (n - 1)));
+    ASSERT_EQ(stats.swaps, 0U);
+}
+
+TEST(SortingStatsTest, RecursionDepth)
+{
+    int n{1 << 16};
+    std::vector<int> values{getShuffledValues(n)};
+    std::vector<int> heap{values};
+    sort::resetSortStats();
+
+    sort::quickSort(values.begin(), values.end());
+
+    // Recursion goes into the smaller part only.
+    std::size_t depth{sort::sortStats().maxDepth};
+    ASSERT_GE(depth, 2U);
+    ASSERT_LE(depth, 17U);
+
+    sort::resetSortStats();
+    sort::heapSort(heap.begin(), heap.end());
+    ASSERT_EQ(sort::sortStats().maxDepth, 0U);
+    ASSERT_GT(sort::sortStats().moves, 0U);
+}
+
+TEST(SortingStatsTest, ScratchBytes)
+{
+    std::size_t n{10000};
+    std::vector<int> values{getShuffledValues(static_cast<int>(n))};
+    std::vector<int> buffer;
+
+    sort::resetSortStats();
+    sort::mergeSort(values.begin(), values.end(), buffer);
+    ASSERT_EQ(sort::sortStats().scratchBytes, n * sizeof(int));
+
+    // A buffer that is large enough is reused.
+    std::shuffle(values.begin(), values.end(), std::mt19937(1));
+    sort::resetSortStats();
+    sort::mergeSort(values.begin(), values.end(), buffer);
+    ASSERT_EQ(sort::sortStats().scratchBytes, 0U);
+
+    sort::resetSortStats();
+    sort::pdqSort(values.begin(), values.end());
+    ASSERT_EQ(sort::sortStats().scratchBytes, 0U);
+
+    std::shuffle(values.begin(), values.end(), std::mt19937(2));
+    sort::resetSortStats();
+    sort::radixSort(values.begin(), values.end());
+    sort::SortStats stats{sort::sortStats()};
+    ASSERT_GE(stats.scratchBytes, n * sizeof(int));
+    ASSERT_EQ(stats.comparisons, 0U);
+    ASSERT_GE(stats.moves, n);
+}
+
+TEST(SortingStatsTest, ParallelSortsCountHelperThreads)
+{
+    int n{1 << 17};
+    std::vector<int> values{getShuffledValues(n)};
+    std::vector<int> radix{values};
+    std::atomic<std::uint64_t> calls{0};
+    sort::resetSortStats();
+
+    sort::parallelMergeSort(values.begin(), values.end(), 4,
+                            CountedLess{&calls});
+
+    sort::SortStats stats{sort::sortStats()};
+    ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+    ASSERT_EQ(stats.comparisons, calls.load());
+    ASSERT_GE(stats.maxDepth, 3U);
+    ASSERT_EQ(stats.scratchBytes, n * sizeof(int));
+
+    sort::resetSortStats();
+    sort::parallelRadixSort(radix.begin(), radix.end(), 4);
+    ASSERT_EQ(radix, values);
+    // Every helper thread moves its chunk through its write buffer.
+    ASSERT_GE(sort::sortStats().moves, 2U * n);
+}
+
+TEST(SortingStatsTest, SelectionAndStringSorts)
+{
+    std::vector<int> values{getShuffledValues(5000)};
+    std::atomic<std::uint64_t> calls{0};
+    sort::resetSortStats();
+
+    sort::nthElement(values.begin(), values.begin() + 100, values.end(),
+                     CountedLess{&calls});
+
+    ASSERT_EQ(sort::sortStats().comparisons, calls.load());
+
+    std::vector<std::string> strings;
+    for (int value : values)
+    {
+        strings.push_back("key" + std::to_string(value));
+    }
+    std::vector<std::string> radix{strings};
+    sort::resetSortStats();
+
+    sort::multikeyQuickSort(strings.begin(), strings.end());
+
+    ASSERT_GT(sort::sortStats().comparisons, 0U);
+    ASSERT_GT(sort::sortStats().maxDepth, 0U);
+
+    sort::resetSortStats();
+    sort::msdRadixSort(radix.begin(), radix.end());
+
+    ASSERT_EQ(radix, strings);
+    ASSERT_EQ(sort::sortStats().scratchBytes,
+              strings.size() * sizeof(std::uint16_t));
+}
+
+TEST(SortingStatsTest, ReportAndReset)
+{
+    std::vector<int> values{getShuffledValues(100)};
+    sort::resetSortStats();
+    sort::quickSort(values.begin(), values.end());
+
+    sort::SortStats stats{sort::sortStats()};
+    std::string report{stats.report()};
+    ASSERT_NE(report.find("comparisons:   " +
+                          std::to_string(stats.comparisons) + "\n"),
+              std::string::npos);
+    ASSERT_NE(report.find("max depth:"), std::string::npos);
+    ASSERT_NE(report.find("scratch bytes: 0\n"), std::string::npos);
+
+    sort::resetSortStats();
+    stats = sort::sortStats();
+    ASSERT_EQ(stats.comparisons, 0U);
+    ASSERT_EQ(stats.swaps, 0U);
+    ASSERT_EQ(stats.moves, 0U);
+    ASSERT_EQ(stats.maxDepth, 0U);
+    ASSERT_EQ(stats.scratchBytes, 0U);
+}
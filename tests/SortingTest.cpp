@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -88,3 +93,654 @@ TEST(SortingTest, HeapSort)
         ASSERT_EQ(numbers[i], i + start);
     }
 }
+
+struct Record
+{
+    int key;
+    int order;
+};
+
+std::vector<Record> getRecordsWithDuplicateKeys(int n)
+{
+    std::vector<int> keys{getRandomOrderedNumbers(0, n)};
+    std::vector<Record> records(n);
+    for (int i{0}; i < n; ++i)
+    {
+        records[i] = {keys[i] % 10, i};
+    }
+    return records;
+}
+
+TEST(SortingTest, DAryHeapSort)
+{
+    std::vector<int> numbers{getRandomOrderedNumbers(MIN_VAL, N_VAL)};
+    std::vector<int> expected{numbers};
+    std::sort(expected.begin(), expected.end());
+
+    for (int n : {0, 1, 2, 3, 4, 5, 17, 100, N_VAL})
+    {
+        std::vector<int> binary(numbers.begin(), numbers.begin() + n);
+        std::vector<int> ternary{binary};
+        std::vector<int> quaternary{binary};
+        std::vector<int> sorted{binary};
+        std::sort(sorted.begin(), sorted.end());
+
+        sort::heapSort<2>(binary.begin(), binary.end());
+        sort::heapSort<3>(ternary.begin(), ternary.end());
+        sort::heapSort<4>(quaternary.begin(), quaternary.end());
+
+        ASSERT_EQ(binary, sorted);
+        ASSERT_EQ(ternary, sorted);
+        ASSERT_EQ(quaternary, sorted);
+    }
+}
+
+TEST(SortingTest, HeapSortWithDuplicatesAndComparator)
+{
+    std::vector<Record> records{getRecordsWithDuplicateKeys(N_VAL)};
+    std::vector<Record> quaternary{records};
+    auto byKeyDescending{[](const Record& a, const Record& b) {
+        return a.key > b.key;
+    }};
+
+    sort::heapSort(records.begin(), records.end(), byKeyDescending);
+    sort::heapSort<4>(quaternary.begin(), quaternary.end(), byKeyDescending);
+
+    for (std::size_t i{1}; i < records.size(); ++i)
+    {
+        ASSERT_GE(records[i - 1].key, records[i].key);
+        ASSERT_GE(quaternary[i - 1].key, quaternary[i].key);
+    }
+}
+
+TEST(SortingTest, GenericSortsHandleEmptyAndSingleRange)
+{
+    std::vector<double> empty;
+    std::vector<double> single{1.0};
+
+    sort::bubbleSort(empty.begin(), empty.end());
+    sort::selectionSort(empty.begin(), empty.end());
+    sort::mergeSort(empty.begin(), empty.end());
+    sort::quickSort(empty.begin(), empty.end());
+    sort::pdqSort(empty.begin(), empty.end());
+    sort::heapSort(empty.begin(), empty.end());
+    sort::mergeSort(single.begin(), single.end());
+    sort::quickSort(single.begin(), single.end());
+    sort::pdqSort(single.begin(), single.end());
+    sort::heapSort(single.begin(), single.end());
+
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(single[0], 1.0);
+}
+
+TEST(SortingTest, GenericSortsOrderDoubles)
+{
+    std::vector<int> ints{getRandomOrderedNumbers(MIN_VAL, 1000)};
+    std::vector<double> numbers(ints.begin(), ints.end());
+    for (double& x : numbers)
+    {
+        x /= 4.0;
+    }
+    std::vector<double> expected{numbers};
+    std::sort(expected.begin(), expected.end());
+
+    for (auto sortFn : {sort::bubbleSort<std::vector<double>::iterator>,
+                        sort::selectionSort<std::vector<double>::iterator>,
+                        sort::mergeSort<std::vector<double>::iterator>,
+                        sort::quickSort<std::vector<double>::iterator>,
+                        sort::pdqSort<std::vector<double>::iterator>,
+                        sort::heapSort<std::vector<double>::iterator>})
+    {
+        std::vector<double> sorted{numbers};
+        sortFn(sorted.begin(), sorted.end(), std::less<>{});
+        ASSERT_EQ(sorted, expected);
+    }
+}
+
+TEST(SortingTest, GenericSortsOrderUnsignedWithComparator)
+{
+    std::vector<int> ints{getRandomOrderedNumbers(0, 1000)};
+    std::vector<uint64_t> numbers;
+    for (int x : ints)
+    {
+        numbers.push_back(static_cast<uint64_t>(x) << 40);
+    }
+    std::vector<uint64_t> expected{numbers};
+    std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+    std::vector<uint64_t> sorted{numbers};
+    sort::mergeSort(sorted.begin(), sorted.end(), std::greater<>{});
+    ASSERT_EQ(sorted, expected);
+
+    sorted = numbers;
+    sort::quickSort(sorted.data(), sorted.data() + sorted.size(),
+                    std::greater<>{});
+    ASSERT_EQ(sorted, expected);
+
+    sorted = numbers;
+    sort::heapSort(sorted.begin(), sorted.end(), std::greater<>{});
+    ASSERT_EQ(sorted, expected);
+}
+
+TEST(SortingTest, MergeSortIsStable)
+{
+    std::vector<Record> records{getRecordsWithDuplicateKeys(N_VAL)};
+
+    sort::mergeSort(records.begin(), records.end(),
+                    [](const Record& a, const Record& b) {
+                        return a.key < b.key;
+                    });
+
+    for (std::size_t i{1}; i < records.size(); ++i)
+    {
+        ASSERT_LE(records[i - 1].key, records[i].key);
+        if (records[i - 1].key == records[i].key)
+        {
+            ASSERT_LT(records[i - 1].order, records[i].order);
+        }
+    }
+}
+
+TEST(SortingTest, TestInsertionSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::insertionSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, QuickSortHandlesPresortedAndEqualInput)
+{
+    int n{1000000};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> equal(n, 7);
+    std::vector<int> fewUnique{getRandomOrderedNumbers(0, n)};
+    for (int& x : fewUnique)
+    {
+        x %= 3;
+    }
+    std::vector<int> organPipe(n);
+    for (int i{0}; i < n; ++i)
+    {
+        organPipe[i] = std::min(i, n - i);
+    }
+
+    for (std::vector<int> numbers : {sorted, reversed, equal, fewUnique,
+                                     organPipe})
+    {
+        std::vector<int> expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::quickSort(numbers.data(), n);
+        ASSERT_EQ(numbers, expected);
+    }
+}
+
+TEST(SortingTest, QuickSortComparisonsStayLinearithmic)
+{
+    int n{1 << 16};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> equal(n, 7);
+
+    for (std::vector<int> numbers : {sorted, equal})
+    {
+        long comparisons{0};
+        sort::quickSort(numbers.begin(), numbers.end(),
+                        [&comparisons](int a, int b) {
+                            ++comparisons;
+                            return a < b;
+                        });
+        ASSERT_TRUE(std::is_sorted(numbers.begin(), numbers.end()));
+        ASSERT_LT(comparisons, 4L * n * 16);
+    }
+}
+
+TEST(SortingTest, QuickSortWithComparator)
+{
+    std::vector<Record> records{getRecordsWithDuplicateKeys(N_VAL)};
+
+    sort::quickSort(records.begin(), records.end(),
+                    [](const Record& a, const Record& b) {
+                        return a.key > b.key;
+                    });
+
+    for (std::size_t i{1}; i < records.size(); ++i)
+    {
+        ASSERT_GE(records[i - 1].key, records[i].key);
+    }
+}
+
+TEST(SortingTest, TestPdqSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::pdqSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, PdqSortHandlesPatterns)
+{
+    int n{100000};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> equal(n, 7);
+    std::vector<int> fewUnique{getRandomOrderedNumbers(0, n)};
+    std::vector<int> sawtooth(n);
+    std::vector<int> organPipe(n);
+    for (int i{0}; i < n; ++i)
+    {
+        fewUnique[i] %= 3;
+        sawtooth[i] = i % 1000;
+        organPipe[i] = std::min(i, n - i);
+    }
+
+    for (std::vector<int> numbers :
+         {sorted, reversed, equal, fewUnique, sawtooth, organPipe})
+    {
+        std::vector<int> expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::pdqSort(numbers.data(), n);
+        ASSERT_EQ(numbers, expected);
+    }
+
+    // Sizes around the insertion sort and block boundaries.
+    std::mt19937 g(5);
+    for (int size{0}; size < 600; ++size)
+    {
+        std::vector<int> numbers(size);
+        std::uniform_int_distribution<int> values(0, size / 4 + 1);
+        for (int& x : numbers)
+        {
+            x = values(g);
+        }
+        std::vector<int> expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::pdqSort(numbers.begin(), numbers.end());
+        ASSERT_EQ(numbers, expected);
+    }
+}
+
+TEST(SortingTest, PdqSortIsLinearOnSortedInput)
+{
+    int n{1 << 16};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> equal(n, 7);
+
+    for (std::vector<int> numbers : {sorted, equal})
+    {
+        long comparisons{0};
+        sort::pdqSort(numbers.begin(), numbers.end(),
+                      [&comparisons](int a, int b) {
+                          ++comparisons;
+                          return a < b;
+                      });
+        ASSERT_TRUE(std::is_sorted(numbers.begin(), numbers.end()));
+        ASSERT_LT(comparisons, 4L * n);
+    }
+}
+
+TEST(SortingTest, PdqSortWithComparator)
+{
+    std::vector<Record> records{getRecordsWithDuplicateKeys(N_VAL)};
+
+    sort::pdqSort(records.begin(), records.end(),
+                  [](const Record& a, const Record& b) {
+                      return a.key > b.key;
+                  });
+
+    for (std::size_t i{1}; i < records.size(); ++i)
+    {
+        ASSERT_GE(records[i - 1].key, records[i].key);
+    }
+}
+
+TEST(SortingTest, TestRadixSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::radixSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, RadixSortSignedAndUnsignedWidths)
+{
+    std::mt19937_64 g(42);
+    std::vector<int64_t> signedNumbers(N_VAL);
+    std::vector<uint64_t> unsignedNumbers(N_VAL);
+    std::vector<int8_t> bytes(N_VAL);
+    std::vector<uint16_t> smallKeys(N_VAL);
+    for (int i{0}; i < N_VAL; ++i)
+    {
+        signedNumbers[i] = static_cast<int64_t>(g());
+        unsignedNumbers[i] = g();
+        bytes[i] = static_cast<int8_t>(g());
+        smallKeys[i] = static_cast<uint16_t>(g() % 200);
+    }
+    signedNumbers[0] = std::numeric_limits<int64_t>::min();
+    signedNumbers[1] = std::numeric_limits<int64_t>::max();
+
+    auto checkRadixSort = [](auto numbers) {
+        auto expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::radixSort(numbers.begin(), numbers.end());
+        return numbers == expected;
+    };
+    ASSERT_TRUE(checkRadixSort(signedNumbers));
+    ASSERT_TRUE(checkRadixSort(unsignedNumbers));
+    ASSERT_TRUE(checkRadixSort(bytes));
+    ASSERT_TRUE(checkRadixSort(smallKeys));
+}
+
+TEST(SortingTest, RadixSortWideIntegerArrays)
+{
+    std::mt19937_64 g(7);
+    std::vector<int64_t> signedNumbers(N_VAL);
+    std::vector<uint64_t> unsignedNumbers(N_VAL);
+    for (int i{0}; i < N_VAL; ++i)
+    {
+        signedNumbers[i] = static_cast<int64_t>(g());
+        unsignedNumbers[i] = g();
+    }
+    std::vector<int64_t> expectedSigned{signedNumbers};
+    std::vector<uint64_t> expectedUnsigned{unsignedNumbers};
+    std::sort(expectedSigned.begin(), expectedSigned.end());
+    std::sort(expectedUnsigned.begin(), expectedUnsigned.end());
+
+    sort::radixSort(signedNumbers.data(), signedNumbers.size());
+    sort::radixSort(unsignedNumbers.data(), unsignedNumbers.size());
+
+    ASSERT_EQ(signedNumbers, expectedSigned);
+    ASSERT_EQ(unsignedNumbers, expectedUnsigned);
+}
+
+TEST(SortingTest, RadixSortFloatingPoint)
+{
+    std::mt19937 g(42);
+    std::uniform_real_distribution<double> values(-1e6, 1e6);
+    std::vector<double> doubles(N_VAL);
+    std::vector<float> floats(N_VAL);
+    for (int i{0}; i < N_VAL; ++i)
+    {
+        doubles[i] = values(g);
+        floats[i] = static_cast<float>(values(g) * 1e-3);
+    }
+    doubles[0] = std::numeric_limits<double>::infinity();
+    doubles[1] = -std::numeric_limits<double>::infinity();
+    doubles[2] = std::numeric_limits<double>::denorm_min();
+    doubles[3] = -std::numeric_limits<double>::denorm_min();
+    doubles[4] = std::numeric_limits<double>::lowest();
+    floats[0] = std::numeric_limits<float>::max();
+    floats[1] = -std::numeric_limits<float>::min();
+
+    auto checkRadixSort = [](auto numbers) {
+        auto expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::radixSort(numbers.data(), numbers.size());
+        return numbers == expected;
+    };
+    ASSERT_TRUE(checkRadixSort(doubles));
+    ASSERT_TRUE(checkRadixSort(floats));
+}
+
+TEST(SortingTest, RadixSortSignedZeroAndNaN)
+{
+    float nan{std::numeric_limits<float>::quiet_NaN()};
+    std::vector<float> numbers{1.0f, nan, 0.0f, -nan, -0.0f, -2.0f, 0.0f,
+                               -0.0f, nan, -1.0f};
+
+    sort::radixSort(numbers.begin(), numbers.end());
+
+    for (int i{0}; i < 7; ++i)
+    {
+        ASSERT_FALSE(std::isnan(numbers[i]));
+    }
+    for (int i{7}; i < 10; ++i)
+    {
+        ASSERT_TRUE(std::isnan(numbers[i]));
+    }
+    ASSERT_EQ(numbers[0], -2.0f);
+    ASSERT_EQ(numbers[1], -1.0f);
+    ASSERT_TRUE(std::signbit(numbers[2]) && std::signbit(numbers[3]));
+    ASSERT_TRUE(!std::signbit(numbers[4]) && !std::signbit(numbers[5]));
+    ASSERT_EQ(numbers[4], 0.0f);
+    ASSERT_EQ(numbers[6], 1.0f);
+}
+
+TEST(SortingTest, TestParallelRadixSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::parallelRadixSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, ParallelRadixSortForAnyThreadCount)
+{
+    std::mt19937_64 g(5);
+    int n{100000};
+    std::vector<int64_t> wide(n);
+    std::vector<uint32_t> narrow(n);
+    std::vector<double> doubles(n);
+    for (int i{0}; i < n; ++i)
+    {
+        wide[i] = static_cast<int64_t>(g());
+        narrow[i] = static_cast<uint32_t>(g() % 1000);
+        doubles[i] = static_cast<double>(static_cast<int64_t>(g())) / 7.0;
+    }
+
+    auto checkParallelRadixSort = [](auto numbers, unsigned threads) {
+        auto expected{numbers};
+        std::sort(expected.begin(), expected.end());
+        sort::parallelRadixSort(numbers.begin(), numbers.end(), threads);
+        return numbers == expected;
+    };
+    for (unsigned threads : {0U, 1U, 2U, 3U, 4U, 7U, 64U})
+    {
+        ASSERT_TRUE(checkParallelRadixSort(wide, threads));
+        ASSERT_TRUE(checkParallelRadixSort(narrow, threads));
+        ASSERT_TRUE(checkParallelRadixSort(doubles, threads));
+    }
+}
+
+TEST(SortingTest, TestParallelMergeSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::parallelMergeSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, ParallelMergeSortIsStableForAnyThreadCount)
+{
+    int n{1 << 18};
+    for (unsigned threads : {1U, 2U, 3U, 8U})
+    {
+        std::vector<Record> records{getRecordsWithDuplicateKeys(n)};
+
+        sort::parallelMergeSort(records.begin(), records.end(), threads,
+                                [](const Record& a, const Record& b) {
+                                    return a.key < b.key;
+                                });
+
+        for (std::size_t i{1}; i < records.size(); ++i)
+        {
+            ASSERT_LE(records[i - 1].key, records[i].key);
+            if (records[i - 1].key == records[i].key)
+            {
+                ASSERT_LT(records[i - 1].order, records[i].order);
+            }
+        }
+    }
+}
+
+TEST(SortingTest, MergeSortWithScratchBuffer)
+{
+    std::vector<int> buffer;
+    for (int n : {N_VAL, 1000, 33, 2, 0, N_VAL})
+    {
+        std::vector<int> numbers{getRandomOrderedNumbers(MIN_VAL, n)};
+        const int* bufferData{buffer.data()};
+
+        sort::mergeSort(numbers.begin(), numbers.end(), buffer);
+
+        for (int i{0}; i < n; ++i)
+        {
+            ASSERT_EQ(numbers[i], i + MIN_VAL);
+        }
+        if (n <= N_VAL && !buffer.empty() && bufferData != nullptr)
+        {
+            // Buffer sized by the first sort is reused without reallocation.
+            ASSERT_EQ(buffer.data(), bufferData);
+        }
+    }
+    ASSERT_EQ(buffer.size(), N_VAL);
+}
+
+TEST(SortingTest, MergeSortWithScratchBufferIsStable)
+{
+    std::vector<Record> buffer;
+    for (int n : {N_VAL, 31, 100, 1025})
+    {
+        std::vector<Record> records{getRecordsWithDuplicateKeys(n)};
+
+        sort::mergeSort(records.begin(), records.end(), buffer,
+                        [](const Record& a, const Record& b) {
+                            return a.key < b.key;
+                        });
+
+        for (std::size_t i{1}; i < records.size(); ++i)
+        {
+            ASSERT_LE(records[i - 1].key, records[i].key);
+            if (records[i - 1].key == records[i].key)
+            {
+                ASSERT_LT(records[i - 1].order, records[i].order);
+            }
+        }
+    }
+}
+
+TEST(SortingTest, TestMergeSortWithRawBuffer)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+    std::vector<int> buffer(n);
+
+    sort::mergeSort(numbers.data(), n, buffer.data());
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, TestTimSort)
+{
+    int start{MIN_VAL};
+    int n{N_VAL};
+    std::vector<int> numbers{getRandomOrderedNumbers(start, n)};
+
+    sort::timSort(numbers.data(), n);
+
+    for (int i{0}; i < n; ++i)
+    {
+        ASSERT_EQ(numbers[i], i + start);
+    }
+}
+
+TEST(SortingTest, TimSortIsStable)
+{
+    std::vector<Record> records{getRecordsWithDuplicateKeys(N_VAL)};
+
+    sort::timSort(records.begin(), records.end(),
+                  [](const Record& a, const Record& b) {
+                      return a.key < b.key;
+                  });
+
+    for (std::size_t i{1}; i < records.size(); ++i)
+    {
+        ASSERT_LE(records[i - 1].key, records[i].key);
+        if (records[i - 1].key == records[i].key)
+        {
+            ASSERT_LT(records[i - 1].order, records[i].order);
+        }
+    }
+}
+
+TEST(SortingTest, TimSortIsAdaptiveOnPresortedInput)
+{
+    int n{1 << 16};
+    std::vector<int> sorted(n);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::vector<int> reversed(sorted.rbegin(), sorted.rend());
+    std::vector<int> withTail{sorted};
+    std::vector<int> tail{getRandomOrderedNumbers(0, n / 100)};
+    std::copy(tail.begin(), tail.end(), withTail.end() - n / 100);
+
+    for (std::vector<int> numbers : {sorted, reversed, withTail})
+    {
+        long comparisons{0};
+        std::vector<int> expected{numbers};
+        std::sort(expected.begin(), expected.end());
+
+        sort::timSort(numbers.begin(), numbers.end(),
+                      [&comparisons](int a, int b) {
+                          ++comparisons;
+                          return a < b;
+                      });
+
+        ASSERT_EQ(numbers, expected);
+        ASSERT_LT(comparisons, 3L * n);
+    }
+}
+
+TEST(SortingTest, StatsStayZeroWithoutInstrumentation)
+{
+    std::vector<int> numbers{getRandomOrderedNumbers(0, 1000)};
+    sort::resetSortStats();
+
+    sort::quickSort(numbers.begin(), numbers.end());
+    sort::mergeSort(numbers.data(), numbers.size());
+
+    sort::SortStats stats{sort::sortStats()};
+    ASSERT_FALSE(sort::INSTRUMENTATION_ENABLED);
+    ASSERT_EQ(stats.comparisons, 0U);
+    ASSERT_EQ(stats.swaps, 0U);
+    ASSERT_EQ(stats.moves, 0U);
+    ASSERT_EQ(stats.maxDepth, 0U);
+    ASSERT_EQ(stats.scratchBytes, 0U);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 #include "DataStructures/Stack.hpp"
 
 TEST(StackTest, CreateEmptyStack)
@@ -72,3 +74,19 @@ TEST(StackTest, PopElements)
     }
     ASSERT_TRUE(stack.empty());
 }
+
+TEST(StackTest, MemoryResource)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    Stack<int, std::pmr::polymorphic_allocator<int>> stack{&arena};
+    for (int i{1}; i < 1000; ++i)
+    {
+        stack.insert(i);
+    }
+    for (int i{999}; i > 0; --i)
+    {
+        ASSERT_EQ(stack.peek(), i);
+        stack.pop();
+    }
+    ASSERT_TRUE(stack.empty());
+}
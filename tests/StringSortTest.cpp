@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Algorithms/StringSort.hpp"
+
+std::vector<std::string> getRandomUrls(int n, int seed)
+{
+    // Long shared prefixes, a few hosts, duplicates and prefixes of others.
+    std::mt19937 g(seed);
+    std::uniform_int_distribution<int> host(0, 5);
+    std::uniform_int_distribution<int> length(0, 12);
+    std::uniform_int_distribution<int> letter('a', 'd');
+    std::vector<std::string> urls(n);
+    for (std::string& url : urls)
+    {
+        url = "https://host" + std::to_string(host(g)) + ".example.com/";
+        for (int i{length(g)}; i > 0; --i)
+        {
+            url += static_cast<char>(letter(g));
+        }
+    }
+    return urls;
+}
+
+std::vector<std::size_t> getLcp(const std::vector<std::string>& sorted)
+{
+    std::vector<std::size_t> lcp(sorted.size(), 0);
+    for (std::size_t i{1}; i < sorted.size(); ++i)
+    {
+        std::size_t length{0};
+        while (length < sorted[i - 1].size() && length < sorted[i].size() &&
+               sorted[i - 1][length] == sorted[i][length])
+        {
+            ++length;
+        }
+        lcp[i] = length;
+    }
+    return lcp;
+}
+
+TEST(StringSortTest, MultikeyQuickSortStrings)
+{
+    for (int n : {0, 1, 2, 15, 16, 17, 100, 10000})
+    {
+        std::vector<std::string> urls{getRandomUrls(n, n)};
+        std::vector<std::string> expected{urls};
+        std::sort(expected.begin(), expected.end());
+
+        sort::multikeyQuickSort(urls.begin(), urls.end());
+
+        ASSERT_EQ(urls, expected);
+    }
+}
+
+TEST(StringSortTest, MsdRadixSortStrings)
+{
+    for (int n : {0, 1, 2, 63, 64, 65, 1000, 10000})
+    {
+        std::vector<std::string> urls{getRandomUrls(n, n)};
+        std::vector<std::string> expected{urls};
+        std::sort(expected.begin(), expected.end());
+
+        sort::msdRadixSort(urls.begin(), urls.end());
+
+        ASSERT_EQ(urls, expected);
+    }
+}
+
+TEST(StringSortTest, SortStringViewsWithoutCopying)
+{
+    std::vector<std::string> storage{getRandomUrls(5000, 1)};
+    std::vector<std::string_view> views(storage.begin(), storage.end());
+    std::vector<std::string_view> radixViews{views};
+    std::vector<std::string_view> expected{views};
+    std::sort(expected.begin(), expected.end());
+
+    sort::multikeyQuickSort(views.begin(), views.end());
+    sort::msdRadixSort(radixViews.begin(), radixViews.end());
+
+    ASSERT_EQ(views, expected);
+    ASSERT_EQ(radixViews, expected);
+    for (std::string_view view : views)
+    {
+        // Views still point into the original strings.
+        ASSERT_TRUE(std::any_of(storage.begin(), storage.end(),
+                                [view](const std::string& s) {
+                                    return s.data() == view.data();
+                                }));
+    }
+}
+
+TEST(StringSortTest, LcpOutput)
+{
+    for (int n : {0, 1, 20, 200, 10000})
+    {
+        std::vector<std::string> urls{getRandomUrls(n, 7)};
+        std::vector<std::string> radix{urls};
+        std::vector<std::size_t> lcp{42};
+        std::vector<std::size_t> radixLcp;
+
+        sort::multikeyQuickSort(urls.begin(), urls.end(), lcp);
+        sort::msdRadixSort(radix.begin(), radix.end(), radixLcp);
+
+        ASSERT_TRUE(std::is_sorted(urls.begin(), urls.end()));
+        ASSERT_EQ(radix, urls);
+        ASSERT_EQ(lcp, getLcp(urls));
+        ASSERT_EQ(radixLcp, getLcp(urls));
+    }
+}
+
+TEST(StringSortTest, BytesOrderAsUnsigned)
+{
+    std::vector<std::string> strings{"\xff", "a", "", "\x80z", "\x01",
+                                     std::string(1, '\0'), "ab"};
+    for (int i{0}; i < 100; ++i)
+    {
+        strings.push_back(std::string(i % 7, static_cast<char>(0xe0 + i)));
+    }
+    std::vector<std::string> expected{strings};
+    std::sort(expected.begin(), expected.end());
+    std::vector<std::string> radix{strings};
+
+    sort::multikeyQuickSort(strings.begin(), strings.end());
+    sort::msdRadixSort(radix.begin(), radix.end());
+
+    ASSERT_EQ(strings, expected);
+    ASSERT_EQ(radix, expected);
+}
+
+TEST(StringSortTest, LongCommonPrefixesAndEqualStrings)
+{
+    // Each string extends the previous one, and many equal strings.
+    std::vector<std::string> strings;
+    for (int i{0}; i < 3000; ++i)
+    {
+        strings.push_back(std::string(static_cast<std::size_t>(i), 'x'));
+    }
+    for (int i{0}; i < 3000; ++i)
+    {
+        strings.push_back("same");
+    }
+    std::shuffle(strings.begin(), strings.end(), std::mt19937(3));
+    std::vector<std::string> expected{strings};
+    std::sort(expected.begin(), expected.end());
+    std::vector<std::string> radix{strings};
+    std::vector<std::size_t> lcp;
+
+    sort::multikeyQuickSort(strings.begin(), strings.end());
+    sort::msdRadixSort(radix.begin(), radix.end(), lcp);
+
+    ASSERT_EQ(strings, expected);
+    ASSERT_EQ(radix, expected);
+    ASSERT_EQ(lcp, getLcp(expected));
+}